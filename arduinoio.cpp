@@ -0,0 +1,200 @@
+/*
+  arduinoio.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 19-Oct-2026
+
+  This work is licensed under the Creative Commons Attribution 4.0 International License.
+  To view a copy of this license, visit http://creativecommons.org/licenses/by/4.0/ or
+  send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+  https://github.com/visualopsholdings/tinylogo
+*/
+
+#include "arduinoio.hpp"
+
+#include <Arduino.h>
+
+#ifdef ESP32
+#include "soc/gpio_struct.h"
+#endif
+
+ArduinoIO::ArduinoIO() {
+
+#ifdef USE_IO_PORTS
+  for (short i=0; i<IO_MAX_PINS; i++) {
+    _pins[i]._port = 0;
+    _pins[i]._mask = 0;
+  }
+  _writecount = 0;
+#endif
+
+}
+
+#ifdef USE_IO_PORTS
+
+void ArduinoIO::cachepin(short pin) {
+
+  if (pin < 0 || pin >= IO_MAX_PINS) {
+    return;
+  }
+#if defined(__AVR__)
+  uint8_t port = digitalPinToPort(pin);
+  if (port == NOT_A_PIN) {
+    return;
+  }
+  // it may have been PWM so let the arduino turn that off the first time.
+  digitalWrite(pin, digitalRead(pin));
+  _pins[pin]._port = portOutputRegister(port);
+  _pins[pin]._mask = digitalPinToBitMask(pin);
+#elif defined(ESP32)
+  // the banks are 1 and 2 so 0 is still not an output.
+  _pins[pin]._port = pin < 32 ? 1 : 2;
+  _pins[pin]._mask = 1UL << (pin & 31);
+#endif
+
+}
+
+void ArduinoIO::write(const ArduinoIOWrite &w) {
+
+#if defined(__AVR__)
+  // the port is shared with interrupts.
+  uint8_t sreg = SREG;
+  cli();
+  *w._port = (*w._port | w._set) & ~w._clear;
+  SREG = sreg;
+#elif defined(ESP32)
+  // these only change the bits that are set so there's no read first.
+  if (w._port == 1) {
+    if (w._set) GPIO.out_w1ts = w._set;
+    if (w._clear) GPIO.out_w1tc = w._clear;
+  }
+  else {
+    if (w._set) GPIO.out1_w1ts.val = w._set;
+    if (w._clear) GPIO.out1_w1tc.val = w._clear;
+  }
+#endif
+
+}
+
+#endif // USE_IO_PORTS
+
+void ArduinoIO::pinmode(short pin, short mode) {
+
+  flush();
+#ifdef USE_IO_PORTS
+  if (pin >= 0 && pin < IO_MAX_PINS) {
+    _pins[pin]._port = 0;
+  }
+#endif
+  pinMode(pin, mode == IO_OUTPUT ? OUTPUT : mode == IO_INPUT_PULLUP ? INPUT_PULLUP : INPUT);
+#ifdef USE_IO_PORTS
+  if (mode == IO_OUTPUT) {
+    cachepin(pin);
+  }
+#endif
+
+}
+
+short ArduinoIO::dread(short pin) {
+
+  // it has to see what we wrote.
+  flush();
+  return digitalRead(pin);
+
+}
+
+void ArduinoIO::dwrite(short pin, bool high) {
+
+#ifdef USE_IO_PORTS
+  if (pin >= 0 && pin < IO_MAX_PINS && _pins[pin]._port) {
+    ArduinoIOPin *p = &_pins[pin];
+    short i = 0;
+    for (; i<_writecount; i++) {
+      if (_writes[i]._port == p->_port) {
+        break;
+      }
+    }
+    if (i < _writecount && ((_writes[i]._set | _writes[i]._clear) & p->_mask)) {
+      // already a write to this pin, it has to go first.
+      flush();
+      i = 0;
+    }
+    if (i >= _writecount) {
+      if (_writecount >= IO_PORTS) {
+        flush();
+      }
+      i = _writecount++;
+      _writes[i]._port = p->_port;
+      _writes[i]._set = 0;
+      _writes[i]._clear = 0;
+    }
+    if (high) {
+      _writes[i]._set |= p->_mask;
+    }
+    else {
+      _writes[i]._clear |= p->_mask;
+    }
+    return;
+  }
+#endif
+  digitalWrite(pin, high ? HIGH : LOW);
+
+}
+
+void ArduinoIO::awrite(short pin, short value) {
+
+  flush();
+#ifdef USE_IO_PORTS
+  // PWM isn't the port anymore.
+  if (pin >= 0 && pin < IO_MAX_PINS) {
+    _pins[pin]._port = 0;
+  }
+#endif
+#ifdef __AVR__
+  analogWrite(pin, value);
+#else
+  // need to implement this on the w32 etc.
+#endif
+
+}
+
+void ArduinoIO::rgbpin(short channel, short pin) {
+
+  flush();
+#ifdef ESP32
+  ledcSetup(channel, 12000, 8); // 12 kHz PWM, 8-bit resolution
+  ledcAttachPin(pin, channel);
+#else
+  pinMode(pin, OUTPUT);
+#endif
+
+}
+
+void ArduinoIO::rgbwrite(short channel, short pin, short value) {
+
+  flush();
+#ifdef ESP32
+  ledcWrite(channel, value);
+#else
+  // 0 is OFF, 255 is FULL.
+  analogWrite(pin, 255 - value);
+#ifdef USE_IO_PORTS
+  if (pin >= 0 && pin < IO_MAX_PINS) {
+    _pins[pin]._port = 0;
+  }
+#endif
+#endif
+
+}
+
+void ArduinoIO::flush() {
+
+#ifdef USE_IO_PORTS
+  for (short i=0; i<_writecount; i++) {
+    write(_writes[i]);
+  }
+  _writecount = 0;
+#endif
+
+}
@@ -0,0 +1,78 @@
+/*
+  arduinoio.hpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 19-Oct-2026
+
+  The pins when on an arduino. Each output pin's port and bit are looked up once
+  and then digital writes go straight to the port, and writes to different pins
+  on the same port are written together at the next flush.
+
+  Boards we don't know the ports for just use digitalWrite.
+
+  This work is licensed under the Creative Commons Attribution 4.0 International License.
+  To view a copy of this license, visit http://creativecommons.org/licenses/by/4.0/ or
+  send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+  https://github.com/visualopsholdings/tinylogo
+*/
+
+#ifndef H_arduinoio
+#define H_arduinoio
+
+#include "logo.hpp"
+
+#if defined(__AVR__)
+#define IO_MAX_PINS         24        // 3 bytes each
+#define IO_PORTS            4         // 4 bytes each
+typedef volatile uint8_t *tIOPort;
+typedef uint8_t tIOMask;
+#define USE_IO_PORTS
+#elif defined(ESP32)
+#define IO_MAX_PINS         40        // 8 bytes each
+#define IO_PORTS            2         // the 2 banks of 32
+typedef short tIOPort;
+typedef uint32_t tIOMask;
+#define USE_IO_PORTS
+#endif
+
+#ifdef USE_IO_PORTS
+typedef struct {
+  tIOPort            _port; // 0 when it's not an output we can write to
+  tIOMask            _mask;
+} ArduinoIOPin;
+
+typedef struct {
+  tIOPort            _port;
+  tIOMask            _set;
+  tIOMask            _clear;
+} ArduinoIOWrite;
+#endif
+
+class ArduinoIO: public LogoIO {
+
+public:
+  ArduinoIO();
+
+  // LogoIO
+  virtual void pinmode(short pin, short mode);
+  virtual short dread(short pin);
+  virtual void dwrite(short pin, bool high);
+  virtual void awrite(short pin, short value);
+  virtual void rgbpin(short channel, short pin);
+  virtual void rgbwrite(short channel, short pin, short value);
+  virtual void flush();
+
+private:
+#ifdef USE_IO_PORTS
+  ArduinoIOPin _pins[IO_MAX_PINS];
+  ArduinoIOWrite _writes[IO_PORTS];
+  short _writecount;
+
+  void cachepin(short pin);
+  void write(const ArduinoIOWrite &w);
+#endif
+
+};
+
+#endif // H_arduinoio
@@ -19,10 +19,16 @@
 using namespace std;
 #endif
 
-ListPool::ListPool() {
+ListPoolBase::ListPoolBase(ListNode *nodes, short size): _nodes(nodes), _size(size) {
+
+  reset();
+  
+}
+
+void ListPoolBase::reset() {
 
   // mark all the nodes as free.
-  short len = sizeof(_nodes) / sizeof(ListNode);
+  short len = _size;
   for (int i=0; i<len; i++) {
     _nodes[i].data1 = 0;
     _nodes[i].data2 = 0;
@@ -30,7 +36,7 @@ ListPool::ListPool() {
   }
 }
   
-void ListPool::add(tNodeType *next, ListNodeVal val) {
+void ListPoolBase::add(tNodeType *next, ListNodeVal val) {
 
   // reserve this node.
   val.copyto(&_nodes[*next]);
@@ -43,7 +49,7 @@ void ListPool::add(tNodeType *next, ListNodeVal val) {
   
 }
 
-bool ListPool::next(tNodeType *node) const {
+bool ListPoolBase::next(tNodeType *node) const {
 
   if (_nodes[*node].next != NODE_FREE) {
     *node = _nodes[*node].next;
@@ -52,14 +58,27 @@ bool ListPool::next(tNodeType *node) const {
   return false;
 }
 
-void ListPool::getdata(tNodeType node, ListNodeVal *val) const {
+void ListPoolBase::getdata(tNodeType node, ListNodeVal *val) const {
   val->copy(_nodes[node]);
 }
 
-int ListPool::free() const {
+int ListPoolBase::used() const {
+
+  // the nodes that are part of some list.
+  int count = 0;
+  short len = _size;
+  for (int i=0; i<len; i++) {
+    if (_nodes[i].next != NODE_FREE) {
+      count++;
+    }
+  }
+  return count;
+}
+
+int ListPoolBase::free() const {
 
   // loop through all nodes and find the next free one.
-  short len = sizeof(_nodes) / sizeof(ListNode);
+  short len = _size;
   for (int i=0; i<len; i++) {
     if (_nodes[i].next == NODE_FREE) {
       return i;
@@ -68,7 +87,7 @@ int ListPool::free() const {
   return -1;
 }
 
-void ListPool::pop(tNodeType *node, ListNodeVal *val) {
+void ListPoolBase::pop(tNodeType *node, ListNodeVal *val) {
 
   tNodeType n = *node;
   
@@ -88,10 +107,10 @@ void ListNodeVal::dump(const char *msg) const {
   cout << (short)_type << " (" << _data1 << ", " << _data2 << ")" << endl;
 }
 
-void ListPool::dump(const char *msg, bool all) const {
+void ListPoolBase::dump(const char *msg, bool all) const {
   
   cout << msg << endl;
-  short len = sizeof(_nodes) / sizeof(ListNode);
+  short len = _size;
   for (int i=0; i<len; i++) {
     if (_nodes[i].next == NODE_FREE) {
       if (all) {
@@ -106,14 +125,14 @@ void ListPool::dump(const char *msg, bool all) const {
 }
 #endif
 
-List::List(ListPool *pool) : _pool(pool) {
+List::List(ListPoolBase *pool) : _pool(pool) {
 
   _head = _pool->free();
   _tail = _head;
   
 }
 
-List::List(ListPool *pool, tNodeType head, tNodeType tail) : _pool(pool) {
+List::List(ListPoolBase *pool, tNodeType head, tNodeType tail) : _pool(pool) {
 
   _head = head;
   _tail = tail;
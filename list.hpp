@@ -18,16 +18,23 @@
 #ifndef H_list
 #define H_list
 
-#define LIST_SIZE   40
+// the size can come from the flashcode tool (see logo.hpp)
+#if defined(ARDUINO) && defined(__has_include)
+#if __has_include("logoconfig.hpp")
+#include "logoconfig.hpp"
+#endif
+#endif
 
-#if LIST_SIZE <= 256
-#define NODE_FREE   255
-typedef unsigned char tNodeType;
-#else
-#define NODE_FREE   -1
-typedef short tNodeType;
+#ifndef LIST_SIZE
+#define LIST_SIZE   40
 #endif
 
+#include "logoindex.hpp"
+
+// big enough for the biggest pool.
+typedef LogoIndex<LIST_SIZE>::type tNodeType;
+#define NODE_FREE   ((tNodeType)LogoIndex<LIST_SIZE>::none)
+
 typedef unsigned char tListDataType;
 
 // these match the optypes in logo.hpp
@@ -38,7 +45,7 @@ typedef unsigned char tListDataType;
 class ListNode {
 
 private:
-  friend class ListPool;
+  friend class ListPoolBase;
   friend class ListNodeVal;
   
   short data1;
@@ -80,10 +87,14 @@ private:
   short _data2;
 };
 
-class ListPool {
+// the nodes are somewhere else, see ListPoolT.
+class ListPoolBase {
 
 public:
-  ListPool();
+  ListPoolBase(ListNode *nodes, short size);
+  
+  void reset();
+  int used() const;
   
 #ifndef ARDUINO
   void dump(const char *msg, bool all) const;
@@ -92,7 +103,8 @@ public:
 private:
   friend class List;
   
-  ListNode _nodes[LIST_SIZE];
+  ListNode *_nodes;
+  short _size;
 
   int free() const;
   void add(tNodeType *next, ListNodeVal val);
@@ -102,11 +114,27 @@ private:
   
 };
 
+// a pool with its own nodes.
+template <short SIZE>
+class ListPoolT: public ListPoolBase {
+
+public:
+  ListPoolT(): ListPoolBase(_store, SIZE) {}
+  
+private:
+  static_assert(sizeof(typename LogoIndex<SIZE>::type) <= sizeof(tNodeType), "make LIST_SIZE as big as the biggest pool");
+  
+  ListNode _store[SIZE];
+  
+};
+
+typedef ListPoolT<LIST_SIZE> ListPool;
+
 class List {
   
 public:
-  List(ListPool *pool);
-  List(ListPool *pool, tNodeType head, tNodeType tail);
+  List(ListPoolBase *pool);
+  List(ListPoolBase *pool, tNodeType head, tNodeType tail);
   
   tNodeType head() const { return _head; }
   tNodeType tail() const { return _tail; }
@@ -118,7 +146,7 @@ public:
   int length() const;
 
 private:
-  ListPool *_pool;
+  ListPoolBase *_pool;
   tNodeType _head;
   tNodeType _tail;
   
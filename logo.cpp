@@ -21,7 +21,7 @@
 #include "arduinodebug.hpp"
 #else
 #include "test/debug.hpp"
-void Logo::outstate() const {
+void LogoBase::outstate() const {
 //  cout << " _inword " << _inword << endl;
 //  cout << " _pc " << _pc << endl;
   cout << endl;
@@ -40,6 +40,7 @@ void Logo::outstate() const {
 #include "logocompiler.hpp"
 #include <iostream>
 #include <sstream>
+#include <chrono>
 using namespace std;
 #endif
 
@@ -49,18 +50,76 @@ using namespace std;
 
 #include "logowordnames.hpp"
 
-Logo::Logo(LogoTimeProvider *time, LogoString *strings, ArduinoFlashCode *code) : 
+LogoBase::LogoBase(const LogoStorage &storage, LogoTimeProvider *time, LogoString *strings, ArduinoFlashCode *code, LogoIO *io) : 
   _nextcode(0), 
   _corenames(coreNames), 
   _corearity(coreArity), 
   _nextstring(0), _fixedstrings(strings), _fixedcount(0), 
   _pc(0), _tos(0), _schedule(time),
   _staticcode(code),
-  _sketch(0)
+  _lists(storage._nodes, storage._nodesize),
+  _sketch(0),
+  _io(io)
   {
   
+  // where everything lives and how big it is.
+  _code = storage._code;
+  _codesize = storage._codesize;
+  _maxcode = storage._maxcode;
+  _startjcode = storage._startjcode;
+#ifdef USE_TASKS
+  _mainstack = storage._stack;
+  _taskstacks = storage._taskstacks;
+  _taskstack = storage._taskstacksize;
+#else
+  _stack = storage._stack;
+#endif
+  _maxstack = storage._stacksize;
+  _variables = storage._vars;
+  _maxvars = storage._varsize;
+  _strings = storage._strings;
+  _poolsize = storage._stringsize;
+  
   _varcount = 0;
-  _nextjcode = START_JCODE;
+  _nextjcode = _startjcode;
+
+#ifdef USE_PROFILE
+  _profiling = false;
+  _profwordcount = 0;
+  _profcallcount = 0;
+#endif
+
+#ifdef USE_TRACE
+  _tracing = false;
+  _tracenext = 0;
+  _tracecount = 0;
+#endif
+
+#ifdef USE_TASKS
+  _stack = _mainstack;
+  _stacksize = _maxstack;
+  _task = 0;
+  _launched = 0;
+  _slice = 0;
+  for (short i=0; i<MAX_TASKS; i++) {
+    _tasks[i]._running = false;
+#ifdef USE_COMMANDS
+    _tasks[i]._command._start = 0;
+    _tasks[i]._command._end = 0;
+#endif
+  }
+  _tasks[0]._running = true;
+#endif
+
+#ifdef USE_EVENTS
+  _handlercount = 0;
+#endif
+
+#ifdef USE_COMMANDS
+  _commandcount = 0;
+  _commandstart = NO_JUMP;
+  _codelimit = _startjcode;
+#endif
 
   reset();
     
@@ -86,10 +145,10 @@ Logo::Logo(LogoTimeProvider *time, LogoString *strings, ArduinoFlashCode *code)
   
   if (_staticcode) {
     short pc = 0;
-    while (pc < MAX_CODE && (*_staticcode)[pc][0] != SCOPTYPE_WORD) {
+    while (pc < _maxcode && (*_staticcode)[pc][0] != SCOPTYPE_WORD) {
       pc++;
     }
-    for (int i=0; pc < MAX_CODE && ((*_staticcode)[pc])[0] != SCOPTYPE_END; i++, pc++) {
+    for (int i=0; pc < _maxcode && ((*_staticcode)[pc])[0] != SCOPTYPE_END; i++, pc++) {
       if ((*_staticcode)[pc][0] == SCOPTYPE_VAR) {
         LogoStringResult result;
         getfixed(&result, i);
@@ -106,10 +165,10 @@ Logo::Logo(LogoTimeProvider *time, LogoString *strings, ArduinoFlashCode *code)
   }
 }
 
-Logo::~Logo() {
+LogoBase::~LogoBase() {
 }
 
-short Logo::run() {
+short LogoBase::run() {
   
   DEBUG_IN(Logo, "run");
   
@@ -118,6 +177,7 @@ short Logo::run() {
     err = step();
   }
   while (!err);
+  flushio();
   
   if (err == LG_STOP) {
     err = 0;
@@ -126,13 +186,33 @@ short Logo::run() {
   return err;
 }
 
-void Logo::restart() {
+void LogoBase::restart() {
 
   DEBUG_IN(Logo, "restart");
   
+#ifdef USE_TASKS
+  // only the main code starts again, any tasks keep going.
+  if (_task != 0) {
+    savetask();
+    loadtask(0);
+  }
+  _tasks[0]._running = true;
+  _slice = 0;
+#endif
+
+#ifdef USE_COMMANDS
+  // it's running everything compiled so far.
+  _tasks[0]._command._start = 0;
+  _tasks[0]._command._end = _nextcode;
+#endif
+
+#ifdef USE_WIFI_ASYNC
+  _wifi.cancel(0);
+#endif
+
   _pc = 0;
   _tos = 0;
-  for (short i=0; i<MAX_STACK; i++) {
+  for (short i=0; i<_maxstack; i++) {
     for (short j=0; j<INST_LENGTH; j++) {
       _stack[i][j] = 0;
     }
@@ -140,28 +220,46 @@ void Logo::restart() {
   
 }
 
-void Logo::reset() {
+void LogoBase::reset() {
 
   DEBUG_IN(Logo, "reset");
   
   // ALL the code
-  short s = (sizeof(_code) / sizeof(tLogoInstruction));
-  for (short i=0; i<s; i++) {
+  for (short i=0; i<_codesize; i++) {
     for (short j=0; j<INST_LENGTH; j++) {
       _code[i][j] = 0;
     }
   }
-  _code[START_JCODE-1][FIELD_OPTYPE] = OPTYPE_HALT;
+  _code[_startjcode-1][FIELD_OPTYPE] = OPTYPE_HALT;
   _nextstring = 0;
   _nextcode = 0;
-  _nextjcode = START_JCODE;
+  _nextjcode = _startjcode;
+  _lists.reset();
+  for (short i=0; i<NUM_CACHE_SIZE; i++) {
+    _numcache[i]._str = 0;
+    _numcache[i]._len = 0;
+    _numcache[i]._int = 0;
+    _numcache[i]._double = 0;
+  }
   
   resetvars();
+#ifdef USE_TASKS
+  stoptasks();
+#endif
+#ifdef USE_EVENTS
+  // the words and names have gone.
+  _handlercount = 0;
+#endif
+#ifdef USE_COMMANDS
+  _commandcount = 0;
+  _commandstart = NO_JUMP;
+  _codelimit = _startjcode;
+#endif
   restart();
   
 }
 
-void Logo::resetvars() {
+void LogoBase::resetvars() {
 
   DEBUG_IN(Logo, "resetvars");
   
@@ -169,12 +267,12 @@ void Logo::resetvars() {
 
 }
 
-void Logo::resetcode() {
+void LogoBase::resetcode() {
 
   DEBUG_IN(Logo, "resetcode");
   
   // Just the code up to the words.
-  short s = min(START_JCODE-1, (sizeof(_code) / sizeof(tLogoInstruction)));
+  short s = min(_startjcode-1, _codesize);
   for (short i=0; i<s; i++) {
     for (short j=0; j<INST_LENGTH; j++) {
       _code[i][j] = 0;
@@ -184,19 +282,29 @@ void Logo::resetcode() {
  
   restart();
   
+#ifdef USE_COMMANDS
+  // the commands have gone too, but not any words that were launched.
+  _commandcount = 0;
+  for (short i=1; i<MAX_TASKS; i++) {
+    if (_tasks[i]._running && _tasks[i]._command._end > 0) {
+      _tasks[i]._running = false;
+      _tasks[i]._command._end = 0;
+      _launched--;
+#ifdef USE_WIFI_ASYNC
+      _wifi.cancel(i);
+#endif
+    }
+  }
+#endif
+
 }
 
-short Logo::parseint(short type, short op, short opand) {
+short LogoBase::parseint(short type, short op, short opand) {
 
   switch (type) {
   
   case OPTYPE_STRING:
-    {
-      LogoStringResult result;
-      getstring(&result, op, opand);
-      return result.toi();
-    }
-    break;
+    return numcache(op, opand)->_int;
     
   case OPTYPE_INT:
   case OPTYPE_DOUBLE:
@@ -211,19 +319,14 @@ short Logo::parseint(short type, short op, short opand) {
   
 }
 
-double Logo::parsedouble(short type, short op, short opand) {
+double LogoBase::parsedouble(short type, short op, short opand) {
 
   DEBUG_IN_ARGS(Logo, "parsedouble", "%i%i%i", type, op, opand);
   
   switch (type) {
   
   case OPTYPE_STRING:
-    {
-      LogoStringResult result;
-      getstring(&result, op, opand);
-      return result.tof();
-    }
-    break;
+    return numcache(op, opand)->_double;
     
   case OPTYPE_INT:
     return (double)op;
@@ -240,11 +343,27 @@ double Logo::parsedouble(short type, short op, short opand) {
   
 }
 
-bool Logo::stackempty() {
+LogoNumCache *LogoBase::numcache(short str, short len) {
+
+  // strings in the pool never change so once one is parsed it can be remembered.
+  LogoNumCache *cache = &_numcache[str % NUM_CACHE_SIZE];
+  if (cache->_str != str || cache->_len != len) {
+    LogoStringResult result;
+    getstring(&result, str, len);
+    cache->_str = str;
+    cache->_len = len;
+    cache->_int = result.toi();
+    cache->_double = result.tof();
+  }
+  return cache;
+  
+}
+
+bool LogoBase::stackempty() {
   return _tos == 0;
 }
 
-short Logo::getvarfromref(short op, short opand) {
+short LogoBase::getvarfromref(short op, short opand) {
 
   DEBUG_IN_ARGS(Logo, "getvarfromref", "%i%i", op, opand);
   
@@ -254,10 +373,16 @@ short Logo::getvarfromref(short op, short opand) {
 
 }
 
-short Logo::popint() {
+short LogoBase::popint() {
 
   DEBUG_IN(Logo, "popint");
   
+  // most of the time it's already an int.
+  if (_tos > 0 && _stack[_tos-1][FIELD_OPTYPE] == OPTYPE_INT) {
+    _tos--;
+    return _stack[_tos][FIELD_OP];
+  }
+  
   if (!pop()) {
     error(LG_STACK_OVERFLOW);
     return 0;
@@ -266,7 +391,23 @@ short Logo::popint() {
   return parseint(_stack[_tos][FIELD_OPTYPE], _stack[_tos][FIELD_OP], _stack[_tos][FIELD_OPAND]);
 }
 
-double Logo::popdouble() {
+bool LogoBase::popints(short *n1, short *n2) {
+
+  DEBUG_IN(Logo, "popints");
+  
+  // only when the top 2 are both ints, otherwise leave them for the slower path.
+  if (_tos < 2 || _stack[_tos-1][FIELD_OPTYPE] != OPTYPE_INT || _stack[_tos-2][FIELD_OPTYPE] != OPTYPE_INT) {
+    return false;
+  }
+  
+  *n1 = _stack[_tos-1][FIELD_OP];
+  *n2 = _stack[_tos-2][FIELD_OP];
+  _tos -= 2;
+  return true;
+  
+}
+
+double LogoBase::popdouble() {
 
   DEBUG_IN(Logo, "popdouble");
   
@@ -279,7 +420,7 @@ double Logo::popdouble() {
 
 }
 
-void Logo::pushint(short n) {
+void LogoBase::pushint(short n) {
 
   DEBUG_IN(Logo, "pushint");
   
@@ -289,18 +430,18 @@ void Logo::pushint(short n) {
 
 }
 
-void Logo::splitdouble(double n, short *op, short *opand) {
+void LogoBase::splitdouble(double n, short *op, short *opand) {
   double i, f;
   f = modf(n, &i);
   *op = (short)i;
   *opand = (short)(f * 10000);
 }
 
-double Logo::joindouble(short op, short opand) const {
+double LogoBase::joindouble(short op, short opand) const {
   return (double)op + ((double)opand)/((double)10000);
 }
 
-void Logo::pushdouble(double n) {
+void LogoBase::pushdouble(double n) {
 
   DEBUG_IN_ARGS(Logo, "pushdouble", "%f", n);
   
@@ -313,7 +454,7 @@ void Logo::pushdouble(double n) {
   
 }
 
-void Logo::pushstring(tStrPool n, tStrPool len) {
+void LogoBase::pushstring(tStrPool n, tStrPool len) {
 
   DEBUG_IN(Logo, "pushstring");
   
@@ -323,7 +464,7 @@ void Logo::pushstring(tStrPool n, tStrPool len) {
   
 }
 
-void Logo::pushstring(LogoString *stri) {
+void LogoBase::pushstring(LogoString *stri) {
 
   short len = stri->length();
   short str = addstring(stri, 0, len);
@@ -331,7 +472,7 @@ void Logo::pushstring(LogoString *stri) {
   
 }
 
-void Logo::pushlist(const List &list) {
+void LogoBase::pushlist(const List &list) {
   
   if (!push(OPTYPE_LIST, list.head(), list.tail())) {
     error(LG_STACK_OVERFLOW);
@@ -339,7 +480,7 @@ void Logo::pushlist(const List &list) {
 
 }
 
-void Logo::fail(short err) {
+void LogoBase::fail(short err) {
   
   DEBUG_IN_ARGS(Logo, "fail", "%i", err);
   
@@ -356,7 +497,7 @@ void Logo::fail(short err) {
   
 }
 
-void Logo::modifyreturn(short rel, short count) {
+void LogoBase::modifyreturn(short rel, short count) {
 
   DEBUG_IN_ARGS(Logo, "modifyreturn", "%i%i", rel, _tos);
   
@@ -366,7 +507,7 @@ void Logo::modifyreturn(short rel, short count) {
 
 }
 
-bool Logo::parsestring(short type, short op, short opand, LogoStringResult *str) {
+bool LogoBase::parsestring(short type, short op, short opand, LogoStringResult *str) {
 
   DEBUG_IN_ARGS(Logo, "parsestring", "%i%i%i", type, op, opand);
   
@@ -377,13 +518,11 @@ bool Logo::parsestring(short type, short op, short opand, LogoStringResult *str)
     return true;
     
   case OPTYPE_INT:
-    snprintf(_numbuf, sizeof(_numbuf), "%d", op);
-    str->_simple.set(_numbuf, strlen(_numbuf));
+    str->_simple.set(_numbuf, formatint(_numbuf, op));
     return true;
     
   case OPTYPE_DOUBLE:
-    snprintf(_numbuf, sizeof(_numbuf), "%f", joindouble(op, opand));
-    str->_simple.set(_numbuf, strlen(_numbuf));
+    str->_simple.set(_numbuf, formatdouble(_numbuf, op, opand));
     return true;
     
   default:
@@ -395,7 +534,50 @@ bool Logo::parsestring(short type, short op, short opand, LogoStringResult *str)
   
 }
 
-bool Logo::pop() {
+short LogoBase::formatint(char *buf, long n) {
+
+  // snprintf is big and slow on the small boards.
+  char *p = buf;
+  if (n < 0) {
+    *p++ = '-';
+    n = -n;
+  }
+  char digits[NUM_LEN];
+  short i = 0;
+  do {
+    digits[i++] = '0' + (n % 10);
+    n /= 10;
+  } while (n);
+  while (i) {
+    *p++ = digits[--i];
+  }
+  *p = 0;
+  return p - buf;
+  
+}
+
+short LogoBase::formatdouble(char *buf, short op, short opand) {
+
+  // the same as "%f" would give for the double but straight from it's parts
+  // which only ever have 4 places.
+  char *p = buf;
+  if (op < 0 || opand < 0) {
+    *p++ = '-';
+  }
+  p += formatint(p, op < 0 ? -(long)op : op);
+  *p++ = '.';
+  short frac = opand < 0 ? -opand : opand;
+  for (short d=1000; d>0; d/=10) {
+    *p++ = '0' + ((frac / d) % 10);
+  }
+  *p++ = '0';
+  *p++ = '0';
+  *p = 0;
+  return p - buf;
+  
+}
+
+bool LogoBase::pop() {
 
   DEBUG_IN(Logo, "pop");
   
@@ -407,7 +589,7 @@ bool Logo::pop() {
   
 }
 
-void Logo::popstring(LogoStringResult *result) {
+void LogoBase::popstring(LogoStringResult *result) {
 
   DEBUG_IN(Logo, "popstring");
   
@@ -424,23 +606,23 @@ void Logo::popstring(LogoStringResult *result) {
   }
 }
 
-bool Logo::isstacklist() {
+bool LogoBase::isstacklist() {
   return _tos > 0 ? _stack[_tos-1][FIELD_OPTYPE] == OPTYPE_LIST : false;
 }
 
-bool Logo::isstackstring() {
+bool LogoBase::isstackstring() {
   return _tos > 0 ? _stack[_tos-1][FIELD_OPTYPE] == OPTYPE_STRING : false;
 }
 
-bool Logo::isstackint() {
+bool LogoBase::isstackint() {
   return _tos > 0 ? _stack[_tos-1][FIELD_OPTYPE] == OPTYPE_INT : false;
 }
 
-bool Logo::isstackdouble() {
+bool LogoBase::isstackdouble() {
   return _tos > 0 ? _stack[_tos-1][FIELD_OPTYPE] == OPTYPE_DOUBLE : false;
 }
 
-List Logo::poplist() {
+List LogoBase::poplist() {
 
   if (isstacklist()) {
     if (!pop()) {
@@ -454,11 +636,11 @@ List Logo::poplist() {
   
 }
 
-bool Logo::push(short type, short op, short opand) {
+bool LogoBase::push(short type, short op, short opand) {
 
   DEBUG_IN_ARGS(Logo, "push", "%i%i", type, op);
   
-  if (_tos >= MAX_STACK) {
+  if (_tos >= stacksize()) {
     return false;
   }
 
@@ -473,14 +655,14 @@ bool Logo::push(short type, short op, short opand) {
   
 }
 
-short Logo::instField(short pc, short field) const {
+short LogoBase::instField(short pc, short field) const {
   if (_staticcode) {
     return (*_staticcode)[pc][field];
   }
   return _code[pc][field];
 }
 
-bool Logo::codeisint(short rel) {
+bool LogoBase::codeisint(short rel) {
 
   DEBUG_IN_ARGS(Logo, "codeisint", "%i", rel);
   
@@ -490,7 +672,20 @@ bool Logo::codeisint(short rel) {
   
 }
 
-short Logo::codetoint(short rel) {
+short LogoBase::codetoword(short rel, short *arity) {
+
+  DEBUG_IN_ARGS(Logo, "codetoword", "%i", rel);
+  
+  short type = instField(_pc+rel, FIELD_OPTYPE);
+  if (type != OPTYPE_JUMP && type != OPTYPE_TAILJUMP) {
+    return -1;
+  }
+  *arity = instField(_pc+rel, FIELD_OPAND);
+  return instField(_pc+rel, FIELD_OP);
+  
+}
+
+short LogoBase::codetoint(short rel) {
 
   DEBUG_IN_ARGS(Logo, "codetoint", "%i", rel);
   
@@ -505,13 +700,13 @@ short Logo::codetoint(short rel) {
 
 }
 
-bool Logo::codeisstring(short rel) {
+bool LogoBase::codeisstring(short rel) {
 
   return instField(_pc+rel, FIELD_OPTYPE) == OPTYPE_STRING;
 
 }
 
-void Logo::codetostring(short rel, tStrPool *s, tStrPool *len) {
+void LogoBase::codetostring(short rel, tStrPool *s, tStrPool *len) {
 
   if (!codeisstring(rel)) {
     error(LG_NOT_STRING);
@@ -522,7 +717,7 @@ void Logo::codetostring(short rel, tStrPool *s, tStrPool *len) {
    
 }
 
-void Logo::jumpskip(short rel) {
+void LogoBase::jumpskip(short rel) {
 
   DEBUG_IN_ARGS(Logo, "jumpskip", "%i", rel);
   
@@ -533,13 +728,13 @@ void Logo::jumpskip(short rel) {
   }
 }
 
-void Logo::jump(short rel) {
+void LogoBase::jump(short rel) {
 
   _pc += rel - 1;
   
 }
 
-bool Logo::call(short jump, tByte arity) {
+bool LogoBase::call(short jump, tByte arity) {
 
   DEBUG_IN_ARGS(Logo, "call", "%i%i", jump, (short)arity);
   
@@ -548,7 +743,7 @@ bool Logo::call(short jump, tByte arity) {
     return true;
   }
   
-  if (_tos >= MAX_STACK) {
+  if (_tos >= stacksize()) {
     return false;
   }
   
@@ -569,23 +764,406 @@ bool Logo::call(short jump, tByte arity) {
   
 }
 
-void Logo::startTry() {
+bool LogoBase::tailcall(short jump, tByte arity) {
+
+  DEBUG_IN_ARGS(Logo, "tailcall", "%i%i", jump, (short)arity);
+  
+  // we can only reuse the frame if our own return address is right on the top
+  // of the stack. Anything else (a FOREVER, a SKIP or some data) and it's
+  // just a normal call.
+  if (arity || _tos == 0 || _stack[_tos-1][FIELD_OPTYPE] != SOPTYPE_RETADDR) {
+    return call(jump, arity);
+  }
+  
+  if (jump == NO_JUMP) {
+    DEBUG_RETURN(" word ignored", 0);
+    return true;
+  }
+  
+  // the word we go to returns to where we would have.
+  _pc = jump - 1;
+  
+  return true;
+  
+}
+
+short LogoBase::stacksize() const {
+
+#ifdef USE_TASKS
+  return _stacksize;
+#else
+  return _maxstack;
+#endif
+
+}
+
+#ifdef USE_TASKS
+
+bool LogoBase::launch(short jump) {
+
+  DEBUG_IN_ARGS(Logo, "launch", "%i", jump);
+  
+  for (short i=1; i<MAX_TASKS; i++) {
+    if (!_tasks[i]._running) {
+      // when the word returns it lands on the halt which ends the task.
+      tLogoInstruction *stack = _taskstacks + (i-1) * _taskstack;
+      stack[0][FIELD_OPTYPE] = SOPTYPE_RETADDR;
+      stack[0][FIELD_OP] = findhalt();
+      stack[0][FIELD_OPAND] = 0;
+      _tasks[i]._running = true;
+      _tasks[i]._pc = jump;
+      _tasks[i]._tos = 1;
+      _tasks[i]._lasttime = 0;
+      _tasks[i]._time = 0;
+#ifdef USE_COMMANDS
+      _tasks[i]._command._start = 0;
+      _tasks[i]._command._end = 0;
+#endif
+      _launched++;
+      return true;
+    }
+  }
+  return false;
+  
+}
+
+void LogoBase::stoptasks() {
+
+  if (_task != 0) {
+    savetask();
+    loadtask(0);
+  }
+  for (short i=1; i<MAX_TASKS; i++) {
+    _tasks[i]._running = false;
+#ifdef USE_COMMANDS
+    _tasks[i]._command._end = 0;
+#endif
+#ifdef USE_WIFI_ASYNC
+    _wifi.cancel(i);
+#endif
+  }
+  _tasks[0]._running = true;
+  _launched = 0;
+  _slice = 0;
+  
+}
+
+void LogoBase::savetask() {
+
+  LogoTask *task = &_tasks[_task];
+  task->_pc = _pc;
+  task->_tos = _tos;
+  _schedule.save(&task->_lasttime, &task->_time);
+  
+}
+
+void LogoBase::loadtask(short task) {
+
+  _task = task;
+  _pc = _tasks[task]._pc;
+  _tos = _tasks[task]._tos;
+  _schedule.restore(_tasks[task]._lasttime, _tasks[task]._time);
+  if (task == 0) {
+    _stack = _mainstack;
+    _stacksize = _maxstack;
+  }
+  else {
+    _stack = _taskstacks + (task-1) * _taskstack;
+    _stacksize = _taskstack;
+  }
+  
+}
+
+void LogoBase::nexttask() {
+
+  _slice = 0;
+  
+  // round robin through the ones that are running.
+  for (short i=1; i<MAX_TASKS; i++) {
+    short task = (_task + i) % MAX_TASKS;
+    if (_tasks[task]._running) {
+      savetask();
+      loadtask(task);
+      return;
+    }
+  }
+  
+}
+
+void LogoBase::endtask() {
+
+  DEBUG_IN(Logo, "endtask");
+  
+  _tasks[_task]._running = false;
+#ifdef USE_COMMANDS
+  _tasks[_task]._command._end = 0;
+#endif
+  _launched--;
+  
+  // when they are all done, the main code will stop at its halt.
+  if (_launched == 0) {
+    _tasks[0]._running = true;
+  }
+  nexttask();
+  
+}
+
+tJump LogoBase::findhalt() const {
+
+#ifdef USE_COMMANDS
+  // the commands have halts too but they get written over, this one doesn't.
+  if (!_staticcode) {
+    return _startjcode-1;
+  }
+#endif
+  tJump pc = 0;
+  while (pc < (_maxcode - 1) && instField(pc, FIELD_OPTYPE) != OPTYPE_HALT) {
+    pc++;
+  }
+  return pc;
+  
+}
+
+#endif // USE_TASKS
+
+#ifdef USE_COMMANDS
+
+bool LogoBase::mainidle() const {
+
+  if (!_tasks[0]._running) {
+    return true;
+  }
+  tJump pc = _task == 0 ? _pc : _tasks[0]._pc;
+  if (pc >= _startjcode) {
+    // in a word.
+    return false;
+  }
+  // at a halt or past the end of its code.
+  return instField(pc, FIELD_OPTYPE) == OPTYPE_HALT || 
+    pc < _tasks[0]._command._start || pc >= _tasks[0]._command._end;
+  
+}
+
+const LogoCommand *LogoBase::commandinuse(short i) const {
+
+  // the tasks then the ones waiting.
+  if (i < MAX_TASKS) {
+    if (!_tasks[i]._running || _tasks[i]._command._end == 0 || (i == 0 && mainidle())) {
+      return 0;
+    }
+    return &_tasks[i]._command;
+  }
+  if (i - MAX_TASKS < _commandcount) {
+    return &_commands[i - MAX_TASKS];
+  }
+  return 0;
+  
+}
+
+tJump LogoBase::commandspace(tJump start) const {
+
+  // up to the first code in use after start.
+  tJump end = _startjcode-1;
+  for (short i=0; i<MAX_TASKS + MAX_COMMANDS; i++) {
+    const LogoCommand *cmd = commandinuse(i);
+    if (!cmd || cmd->_end <= start || cmd->_start >= end) {
+      continue;
+    }
+    if (cmd->_start <= start) {
+      return start;
+    }
+    end = cmd->_start;
+  }
+  return end;
+  
+}
+
+bool LogoBase::startcommand(short len) {
+
+  DEBUG_IN_ARGS(Logo, "startcommand", "%i", len);
+  
+  // the main code can't be sitting on a halt that might be written over.
+  if (mainidle()) {
+    if (_task == 0) {
+      _pc = _startjcode-1;
+    }
+    else {
+      _tasks[0]._pc = _startjcode-1;
+    }
+    _tasks[0]._command._end = 0;
+  }
+  else if (_tasks[0]._command._end == _nextcode && _nextcode > 0 && 
+      instField(_nextcode-1, FIELD_OPTYPE) != OPTYPE_HALT && _nextcode < _startjcode-1) {
+    // it's still running the code from before, stop it running on into this.
+    addop(&_nextcode, OPTYPE_HALT);
+    _tasks[0]._command._end = _nextcode;
+  }
+  
+  // every token is at least a character and the halt goes after them.
+  short need = len + 1;
+  tJump start = _nextcode;
+  tJump end = commandspace(start);
+  // go around to the top, then try after each one in use.
+  for (short i=-1; end - start < need && i < MAX_TASKS + MAX_COMMANDS; i++) {
+    if (i < 0) {
+      start = 0;
+    }
+    else {
+      const LogoCommand *cmd = commandinuse(i);
+      if (!cmd) {
+        continue;
+      }
+      start = cmd->_end;
+    }
+    end = commandspace(start);
+  }
+  if (end - start < need) {
+    return false;
+  }
+  
+  // only clear what we use.
+  end = start + need;
+  for (short i=start; i<end; i++) {
+    for (short j=0; j<INST_LENGTH; j++) {
+      _code[i][j] = 0;
+    }
+  }
+  _nextcode = start;
+  _commandstart = start;
+  _codelimit = end - 1;
+  return true;
+  
+}
+
+void LogoBase::abandoncommand() {
+
+  DEBUG_IN(Logo, "abandoncommand");
+  
+  if (_commandstart == NO_JUMP) {
+    return;
+  }
+  for (short i=_commandstart; i<_nextcode; i++) {
+    for (short j=0; j<INST_LENGTH; j++) {
+      _code[i][j] = 0;
+    }
+  }
+  _nextcode = _commandstart;
+  _commandstart = NO_JUMP;
+  _codelimit = _startjcode;
+  
+}
+
+short LogoBase::endcommand() {
+
+  DEBUG_IN(Logo, "endcommand");
+  
+  if (_commandstart == NO_JUMP) {
+    return 0;
+  }
+  if (_nextcode == _commandstart) {
+    // nothing to run, it just defined words.
+    _commandstart = NO_JUMP;
+    _codelimit = _startjcode;
+    return 0;
+  }
+  addop(&_nextcode, OPTYPE_HALT);
+  LogoCommand cmd;
+  cmd._start = _commandstart;
+  cmd._end = _nextcode;
+  _commandstart = NO_JUMP;
+  _codelimit = _startjcode;
+  
+  // keep them in order behind any that are waiting.
+  if (_commandcount == 0 && runcommand(cmd)) {
+    return 0;
+  }
+  if (_commandcount >= MAX_COMMANDS) {
+    // nowhere for it to go.
+    for (short i=cmd._start; i<cmd._end; i++) {
+      for (short j=0; j<INST_LENGTH; j++) {
+        _code[i][j] = 0;
+      }
+    }
+    _nextcode = cmd._start;
+    return LG_TOO_MANY_TASKS;
+  }
+  _commands[_commandcount++] = cmd;
+  return 0;
+  
+}
+
+void LogoBase::runmain(const LogoCommand &cmd) {
+
+  LogoTask *task = &_tasks[0];
+  if (_task == 0) {
+    _pc = cmd._start;
+    _tos = 0;
+    _schedule.restore(0, 0);
+  }
+  else {
+    task->_pc = cmd._start;
+    task->_tos = 0;
+    task->_lasttime = 0;
+    task->_time = 0;
+  }
+  task->_running = true;
+  task->_command = cmd;
+  
+}
+
+bool LogoBase::runcommand(const LogoCommand &cmd) {
+
+  // on the main code when it has finished, otherwise alongside it.
+  if (mainidle()) {
+    runmain(cmd);
+    return true;
+  }
+  for (short i=1; i<MAX_TASKS; i++) {
+    if (!_tasks[i]._running) {
+      launch(cmd._start);
+      // it runs to its own halt so doesn't need anything to return to.
+      _tasks[i]._tos = 0;
+      _tasks[i]._command = cmd;
+      return true;
+    }
+  }
+  return false;
+  
+}
+
+bool LogoBase::runpending() {
+
+  bool ran = false;
+  while (_commandcount > 0 && runcommand(_commands[0])) {
+    _commandcount--;
+    for (short i=0; i<_commandcount; i++) {
+      _commands[i] = _commands[i+1];
+    }
+    ran = true;
+  }
+  return ran;
+  
+}
+
+#endif // USE_COMMANDS
+
+void LogoBase::startTry() {
 
   // find the catch and push it onto the stack
   
   int pc = _pc;
-  while (pc < (CODE_SIZE - 1) && _code[pc][FIELD_OPTYPE] != OPTYPE_CATCH) {
+  while (pc < (_codesize - 1) && _code[pc][FIELD_OPTYPE] != OPTYPE_CATCH) {
     pc++;
   }
   
   // if we don't find a catch just ignore the try
-  if (pc < (CODE_SIZE - 1)) {
+  if (pc < (_codesize - 1)) {
     push(SOPTYPE_TRY, pc);
   }
   
 }
 
-void Logo::finishThrow(short str, short len) {
+void LogoBase::finishThrow(short str, short len) {
 
   _exception = str;
   _exclength = len;
@@ -613,7 +1191,7 @@ void Logo::finishThrow(short str, short len) {
 
 }
 
-void Logo::doThrow() {
+void LogoBase::doThrow() {
 
   // pop the string off the stack as the exception
   if (!pop()) {
@@ -629,14 +1207,14 @@ void Logo::doThrow() {
   
 }
 
-void Logo::pushException() {
+void LogoBase::pushException() {
 
   pushstring(_exception, _exclength);
 
 }
 
 #ifdef ARDUINO
-void Logo::printException() {
+void LogoBase::printException() {
   
   LogoStringResult result;
   getstring(&result, _exception, _exclength);
@@ -645,14 +1223,14 @@ void Logo::printException() {
 }
 #endif
 
-void Logo::throwException(const char *s) {
+void LogoBase::throwException(const char *s) {
 
   LogoSimpleString str(s);
   finishThrow(addstring(&str, 0, str.length()), str.length());
 
 }
 
-void Logo::handleCatch() {
+void LogoBase::handleCatch() {
 
   // we hit a catch without throwing, so just jump over it.
   _pc++;
@@ -666,8 +1244,8 @@ void Logo::handleCatch() {
   }
 }
 
-void Logo::halt() {
-  while (_pc < (CODE_SIZE - 1)) {
+void LogoBase::halt() {
+  while (_pc < (_codesize - 1)) {
     if (_code[_pc+1][FIELD_OPTYPE] == OPTYPE_HALT) {
       return;
     }
@@ -675,7 +1253,7 @@ void Logo::halt() {
   }
 }
 
-bool Logo::isnum(LogoString *stri, short wordstart, short wordlen) {
+bool LogoBase::isnum(LogoString *stri, short wordstart, short wordlen) {
 
   if (wordlen == 0) {
     return false;
@@ -690,7 +1268,7 @@ bool Logo::isnum(LogoString *stri, short wordstart, short wordlen) {
   
 }
 
-int Logo::callword(const char *word) {
+int LogoBase::callword(const char *word) {
 
   DEBUG_IN_ARGS(Logo, "callword", "%s", word);
   
@@ -731,7 +1309,7 @@ int Logo::callword(const char *word) {
   }
   
   int w = 0;
-  for (short i=0; i<MAX_CODE; i++) {
+  for (short i=0; i<_maxcode; i++) {
     short type = instField(i, FIELD_OPTYPE);
     if (type == SCOPTYPE_WORD) {
       if (w == n) {
@@ -755,28 +1333,115 @@ int Logo::callword(const char *word) {
     }
   }
   
-  return LG_OUT_OF_CODE;
+  return LG_OUT_OF_CODE;
+}
+
+void LogoBase::schedulenext(short delay) {
+  // anything written goes out before the wait.
+  flushio();
+  _schedule.schedule(delay); 
+}
+
+void LogoBase::getbuiltinname(short op, char *s, int len) const {
+  LogoStringResult result;
+  if (getfixedcr(&_corenames, &result, op)) {
+    result.ncpy(s, len);
+    s[len-1] = 0;
+  }
+  else {
+    s[0] = 0;
+  }
+}
+
+#ifdef USE_EVENTS
+
+bool LogoBase::when(tStrPool name, tStrPool len, short jump) {
+
+  DEBUG_IN_ARGS(Logo, "when", "%i", jump);
+  
+  // the same event again just changes the word.
+  for (short i=0; i<_handlercount; i++) {
+    if (_handlers[i]._namelen == len) {
+      LogoStringResult result;
+      getstring(&result, name, len);
+      if (stringcmp(&result, _handlers[i]._name, _handlers[i]._namelen)) {
+        _handlers[i]._jump = jump;
+        return true;
+      }
+    }
+  }
+  if (_handlercount >= MAX_HANDLERS) {
+    return false;
+  }
+  _handlers[_handlercount]._name = name;
+  _handlers[_handlercount]._namelen = len;
+  _handlers[_handlercount]._jump = jump;
+  _handlercount++;
+  return true;
+  
+}
+
+void LogoBase::dispatchevents() {
+
+  // at most one go around the queue so a burst can't hold up the code.
+  for (short n=0; n<EVENT_QUEUE_LEN; n++) {
+    LogoEvent *event = _events.front();
+    if (!event) {
+      return;
+    }
+    LogoSimpleString name(event->_name);
+    short i = 0;
+    while (i < _handlercount && !stringcmp(&name, 0, name.length(), _handlers[i]._name, _handlers[i]._namelen)) {
+      i++;
+    }
+    // when all the tasks are busy it stays in the queue for next time.
+    if (i < _handlercount && !launch(_handlers[i]._jump)) {
+      return;
+    }
+    _events.pop();
+  }
+  
 }
 
-void Logo::schedulenext(short delay) {
-  _schedule.schedule(delay); 
-}
+#endif // USE_EVENTS
 
-void Logo::getbuiltinname(short op, char *s, int len) const {
-  LogoStringResult result;
-  if (getfixedcr(&_corenames, &result, op)) {
-    result.ncpy(s, len);
-    s[len-1] = 0;
-  }
-  else {
-    s[0] = 0;
-  }
+#ifdef USE_WIFI_ASYNC
+bool LogoBase::wifiwaiting() {
+
+#ifdef USE_TASKS
+  short task = _task;
+#else
+  short task = 0;
+#endif
+  // when it's done the result goes on the stack (or it throws) and we keep going.
+  return _wifi.pending(task) && !_wifi.finish(this, task);
+  
 }
+#endif
 
-short Logo::step() {
+short LogoBase::step() {
 
 //  DEBUG_IN(Logo, "step");
   
+#ifdef USE_EVENTS
+  if (!_events.empty()) {
+    dispatchevents();
+  }
+#endif
+
+#ifdef USE_TASKS
+  // give the other tasks a go when this one is waiting or has had enough.
+  if (_launched > 0 && (_schedule.waiting() || wifiwaiting() || ++_slice >= TASK_QUANTUM)) {
+    nexttask();
+  }
+#endif
+
+#ifdef USE_WIFI_ASYNC
+  if (wifiwaiting()) {
+    return 0;
+  }
+#endif
+
   // quickly get to the end.
   if (_tos == 0 && instField(_pc, FIELD_OPTYPE) == OPTYPE_NOOP) {
     _pc++;
@@ -787,6 +1452,18 @@ short Logo::step() {
     return 0;
   }
   
+#ifdef USE_PROFILE
+  if (_profiling) {
+    profilestep();
+  }
+#endif
+
+#ifdef USE_TRACE
+  if (_tracing) {
+    tracestep();
+  }
+#endif
+
   if (doarity()) {
     return 0;
   }
@@ -815,6 +1492,28 @@ short Logo::step() {
   switch (type) {
   
   case OPTYPE_HALT:
+#ifdef USE_TASKS
+    // a task returned from its word.
+    if (_task > 0) {
+      endtask();
+#ifdef USE_COMMANDS
+      runpending();
+#endif
+      return 0;
+    }
+#ifdef USE_COMMANDS
+    // the next command that was waiting.
+    if (runpending()) {
+      return 0;
+    }
+#endif
+    // the main code is done but the tasks aren't.
+    if (_launched > 0) {
+      _tasks[0]._running = false;
+      nexttask();
+      return 0;
+    }
+#endif
     return LG_STOP;
     
 //   case OPTYPE_NOOP:
@@ -846,6 +1545,7 @@ short Logo::step() {
   case OPTYPE_STRING:
   case OPTYPE_INT:
   case OPTYPE_DOUBLE:
+  case OPTYPE_LIST:
     err = pushvalue(type, instField(_pc, FIELD_OP), instField(_pc, FIELD_OPAND));
     break;
     
@@ -878,12 +1578,30 @@ short Logo::step() {
     
   case OPTYPE_JUMP:
     {
+#ifdef USE_PROFILE
+      if (_profiling) {
+        profilecall(instField(_pc, FIELD_OP));
+      }
+#endif
       if (!call(instField(_pc, FIELD_OP), instField(_pc, FIELD_OPAND))) {
         err = LG_STACK_OVERFLOW;
       }
     }
     break;
     
+  case OPTYPE_TAILJUMP:
+    {
+#ifdef USE_PROFILE
+      if (_profiling) {
+        profilecall(instField(_pc, FIELD_OP));
+      }
+#endif
+      if (!tailcall(instField(_pc, FIELD_OP), instField(_pc, FIELD_OPAND))) {
+        err = LG_STACK_OVERFLOW;
+      }
+    }
+    break;
+    
   case OPTYPE_ERR:
     err = instField(_pc, FIELD_OP);
     break;
@@ -910,7 +1628,7 @@ short Logo::step() {
   
 }
 
-short Logo::pushvalue(short type, short op, short opand) {
+short LogoBase::pushvalue(short type, short op, short opand) {
 
   if (_stack[_tos-1][FIELD_OPTYPE] == SOPTYPE_OPENLIST) {
     // append to the open list.
@@ -930,7 +1648,7 @@ short Logo::pushvalue(short type, short op, short opand) {
 }
 
 // this is not quite sufficient for nested infixes. Still work to do.
-bool Logo::doinfix() {
+bool LogoBase::doinfix() {
 
   DEBUG_IN(Logo, "doinfix");
 
@@ -960,7 +1678,7 @@ bool Logo::doinfix() {
   return false;
 }
 
-bool Logo::doarity() {
+bool LogoBase::doarity() {
 
   DEBUG_IN(Logo, "doarity");
 
@@ -1054,7 +1772,7 @@ bool Logo::doarity() {
   return false;
 }
 
-short Logo::startgroup() {
+short LogoBase::startgroup() {
 
   DEBUG_IN(Logo, "startgroup");
 
@@ -1065,7 +1783,7 @@ short Logo::startgroup() {
   return 0;
 }
 
-short Logo::endgroup() {
+short LogoBase::endgroup() {
 
   DEBUG_IN(Logo, "endgroup");
 
@@ -1086,14 +1804,14 @@ short Logo::endgroup() {
   return 0;
 }
 
-List Logo::newlist() {
+List LogoBase::newlist() {
 
   List l(&_lists);
   return l;
   
 }
 
-short Logo::startlist() {
+short LogoBase::startlist() {
 
   DEBUG_IN(Logo, "startlist");
 
@@ -1107,7 +1825,7 @@ short Logo::startlist() {
   return 0;
 }
 
-short Logo::endlist() {
+short LogoBase::endlist() {
 
   DEBUG_IN(Logo, "endlist");
 
@@ -1120,7 +1838,7 @@ short Logo::endlist() {
   
 }
 
-short Logo::dobuiltin() {
+short LogoBase::dobuiltin() {
 
   DEBUG_IN(Logo, "dobuiltin");
 
@@ -1145,7 +1863,7 @@ short Logo::dobuiltin() {
   
 }
 
-short Logo::doreturn() {
+short LogoBase::doreturn() {
 
   DEBUG_IN(Logo, "doreturn");
 
@@ -1214,7 +1932,7 @@ short Logo::doreturn() {
     
 }
 
-void Logo::addop(tJump *next, short type, short op, short opand) {
+void LogoBase::addop(tJump *next, short type, short op, short opand) {
 
   DEBUG_IN_ARGS(Logo, "addop", "%i%i%i", type, op, opand);
 
@@ -1232,13 +1950,61 @@ void Logo::addop(tJump *next, short type, short op, short opand) {
   
 }
 
-short Logo::findbuiltin(LogoString *str, short start, short slen) {
+void LogoBase::marktailcall(tJump last) {
+
+  DEBUG_IN_ARGS(Logo, "marktailcall", "%i", last);
+
+  if (_staticcode) {
+    return;
+  }
+  
+  // only a call with no arguments can reuse the frame.
+  if (_code[last][FIELD_OPTYPE] == OPTYPE_JUMP && _code[last][FIELD_OPAND] == 0) {
+    _code[last][FIELD_OPTYPE] = OPTYPE_TAILJUMP;
+  }
+  
+}
+
+bool LogoBase::constlist(tJump start, tJump *next) {
+
+  DEBUG_IN_ARGS(Logo, "constlist", "%i%i", start, *next);
+
+  if (_staticcode) {
+    return false;
+  }
+  
+  // only a list of literals can be built now.
+  for (tJump i=start+1; i<*next; i++) {
+    short type = _code[i][FIELD_OPTYPE];
+    if (type != OPTYPE_STRING && type != OPTYPE_INT && type != OPTYPE_DOUBLE) {
+      return false;
+    }
+  }
+  
+  List list(&_lists);
+  for (tJump i=start+1; i<*next; i++) {
+    ListNodeVal val(_code[i][FIELD_OPTYPE], _code[i][FIELD_OP], _code[i][FIELD_OPAND]);
+    list.push(val);
+    for (short j=0; j<INST_LENGTH; j++) {
+      _code[i][j] = 0;
+    }
+  }
+  
+  // replace the [ and all the literals with the list.
+  *next = start;
+  addop(next, OPTYPE_LIST, list.head(), list.tail());
+  
+  return true;
+  
+}
+
+short LogoBase::findbuiltin(LogoString *str, short start, short slen) {
 
   return findcrstring(&_corenames, str, start, slen);
   
 }
 
-short Logo::findcrstring(const LogoString *strings, const LogoString *stri, short strstart, short slen) {
+short LogoBase::findcrstring(const LogoString *strings, const LogoString *stri, short strstart, short slen) {
 
   if (strings) {
 //    strings->dump("findfixed", 0, strings->length());
@@ -1260,7 +2026,7 @@ short Logo::findcrstring(const LogoString *strings, const LogoString *stri, shor
   
 }
 
-short Logo::findfixed(const LogoString *stri, short strstart, short slen) const {
+short LogoBase::findfixed(const LogoString *stri, short strstart, short slen) const {
 
   DEBUG_IN_ARGS(Logo, "findfixed", "%i%i", strstart, slen);
   
@@ -1268,7 +2034,7 @@ short Logo::findfixed(const LogoString *stri, short strstart, short slen) const
 
 }
 
-bool Logo::fixedcmp(const LogoString *stri, short strstart, short slen, tStrPool str, tStrPool len) const {
+bool LogoBase::fixedcmp(const LogoString *stri, short strstart, short slen, tStrPool str, tStrPool len) const {
 
 //  DEBUG_IN_ARGS(Logo, "fixedcmp", "%i%i%i%i", strstart, slen, str, len);
   
@@ -1293,7 +2059,7 @@ bool Logo::fixedcmp(const LogoString *stri, short strstart, short slen, tStrPool
   
 }
 
-bool Logo::getfixedcr(const LogoString *strings, LogoStringResult *result, short ind) {
+bool LogoBase::getfixedcr(const LogoString *strings, LogoStringResult *result, short ind) {
 
   if (strings) {
     short start = 0;
@@ -1316,7 +2082,7 @@ bool Logo::getfixedcr(const LogoString *strings, LogoStringResult *result, short
   return false;
 }
 
-bool Logo::getfixed(LogoStringResult *result, tStrPool str) const {
+bool LogoBase::getfixed(LogoStringResult *result, tStrPool str) const {
 
 //  DEBUG_IN_ARGS(Logo, "getfixed", "%i", str);
   
@@ -1328,7 +2094,7 @@ bool Logo::getfixed(LogoStringResult *result, tStrPool str) const {
   return false;
 }
 
-short Logo::addstring(const LogoString *str, short start, short slen) {
+short LogoBase::addstring(const LogoString *str, short start, short slen) {
 
   DEBUG_IN_ARGS(Logo, "addstring", "%i%i", start, slen);
   
@@ -1338,7 +2104,7 @@ short Logo::addstring(const LogoString *str, short start, short slen) {
     return existing;
   }
 
-  if ((_nextstring + slen) >= STRING_POOL_SIZE) {
+  if ((_nextstring + slen) >= _poolsize) {
     DEBUG_RETURN(" %i", -1);
     return -1;
   }
@@ -1352,7 +2118,7 @@ short Logo::addstring(const LogoString *str, short start, short slen) {
   return stri;
 }
 
-short Logo::addstring(LogoStringResult *stri) {
+short LogoBase::addstring(LogoStringResult *stri) {
 
   if (stri->_fixed) {
     return addstring(stri->_fixed, stri->_fixedstart, stri->_fixedlen);
@@ -1361,7 +2127,7 @@ short Logo::addstring(LogoStringResult *stri) {
 
 }
 
-bool Logo::stringcmp(const LogoString *stri, short start, short slen, tStrPool str, tStrPool len) const {
+bool LogoBase::stringcmp(const LogoString *stri, short start, short slen, tStrPool str, tStrPool len) const {
 
   if (slen != len) {
     return false;
@@ -1375,7 +2141,7 @@ bool Logo::stringcmp(const LogoString *stri, short start, short slen, tStrPool s
   
 }
 
-bool Logo::stringcmp(LogoStringResult *stri, tStrPool str, tStrPool len) const {
+bool LogoBase::stringcmp(LogoStringResult *stri, tStrPool str, tStrPool len) const {
 
 //  DEBUG_IN(Logo, "stringcmp");
   
@@ -1393,7 +2159,7 @@ bool Logo::stringcmp(LogoStringResult *stri, tStrPool str, tStrPool len) const {
   
 }
 
-void Logo::getstring(LogoStringResult *stri, tStrPool str, tStrPool len) const {
+void LogoBase::getstring(LogoStringResult *stri, tStrPool str, tStrPool len) const {
 
 //  DEBUG_IN_ARGS(Logo, "getstring", "%i%i", str, len);
   
@@ -1407,7 +2173,7 @@ void Logo::getstring(LogoStringResult *stri, tStrPool str, tStrPool len) const {
   
 }
 
-short Logo::findvariable(LogoString *stri, short start, short slen) const {
+short LogoBase::findvariable(LogoString *stri, short start, short slen) const {
 
   DEBUG_IN_ARGS(Logo, "findvariable", "%i%i", start, _varcount);
   
@@ -1420,7 +2186,7 @@ short Logo::findvariable(LogoString *stri, short start, short slen) const {
   return -1;
 }
 
-short Logo::findvariable(LogoStringResult *stri) const {
+short LogoBase::findvariable(LogoStringResult *stri) const {
 
   DEBUG_IN_ARGS(Logo, "findvariable", "%i", _varcount);
   
@@ -1435,12 +2201,12 @@ short Logo::findvariable(LogoStringResult *stri) const {
   return -1;
 }
 
-short Logo::geterr() {
+short LogoBase::geterr() {
 
   DEBUG_IN(Logo, "geterr");
   
   // walk through the code looking for errors.
-  for (short i=0; i<CODE_SIZE; i++) {
+  for (short i=0; i<_codesize; i++) {
     if (_code[i][FIELD_OPTYPE] == OPTYPE_ERR) {
       DEBUG_RETURN(" code %i", i);
       return _code[i][FIELD_OP];
@@ -1453,12 +2219,12 @@ short Logo::geterr() {
   
 }
 
-bool Logo::haserr(short err) {
+bool LogoBase::haserr(short err) {
 
   DEBUG_IN_ARGS(Logo, "haserr", "%i", err);
   
   // walk through the code looking for a particular error.
-  for (short i=0; i<CODE_SIZE; i++) {
+  for (short i=0; i<_codesize; i++) {
     if (_code[i][FIELD_OPTYPE] == OPTYPE_ERR && _code[i][FIELD_OP] == err) {
       return true;
     }
@@ -1467,27 +2233,33 @@ bool Logo::haserr(short err) {
   return false;
 }
 
-void Logo::error(short error) {
+void LogoBase::error(short error) {
   addop(&_nextcode, OPTYPE_ERR, error);
 }
 
-void Logo::outofcode() {
+void LogoBase::outofcode() {
 
   // if we run out code, put the error as the FIRST instruction
   // and reset the pc so that we simply fill it up again this
   // will allow people to see what code overflowed.
   _nextcode = 0;
+#ifdef USE_COMMANDS
+  // but not over anything that is running.
+  if (_commandstart != NO_JUMP) {
+    _nextcode = _commandstart;
+  }
+#endif
   addop(&_nextcode, OPTYPE_ERR, LG_OUT_OF_CODE);
 
 }
 
-short Logo::newintvar(short str, short slen, short n) {
+short LogoBase::newintvar(short str, short slen, short n) {
 
   if (str < 0) {
     error(LG_OUT_OF_STRINGS);
     return -1;
   }
-  if (_varcount >= MAX_VARS) {
+  if (_varcount >= _maxvars) {
     error(LG_TOO_MANY_VARS);
     return -1;
   }
@@ -1501,7 +2273,7 @@ short Logo::newintvar(short str, short slen, short n) {
   return var;
   
 }
-void Logo::setintvar(short var, short n) {
+void LogoBase::setintvar(short var, short n) {
 
   _variables[var]._type = OPTYPE_INT;
   _variables[var]._value = n;
@@ -1509,13 +2281,13 @@ void Logo::setintvar(short var, short n) {
   
 }
 
-short Logo::newstringvar(short str, short slen, short vstr, short vlen) {
+short LogoBase::newstringvar(short str, short slen, short vstr, short vlen) {
 
   if (str < 0 || vstr < 0) {
     error(LG_OUT_OF_STRINGS);
     return -1;
   }
-  if (_varcount >= MAX_VARS) {
+  if (_varcount >= _maxvars) {
     error(LG_TOO_MANY_VARS);
     return -1;
   }
@@ -1529,7 +2301,15 @@ short Logo::newstringvar(short str, short slen, short vstr, short vlen) {
   return var;
 }
 
-void Logo::setstringvar(short var, short vstr, short vlen) {
+bool LogoBase::intstring(LogoStringResult *str, short *n) {
+
+  // only if the string is exactly what the int would print as, so "007" stays a string.
+  *n = str->toi();
+  return (short)str->length() == formatint(_numbuf, *n) && str->ncmp(_numbuf) == 0;
+  
+}
+
+void LogoBase::setstringvar(short var, short vstr, short vlen) {
 
   _variables[var]._type = OPTYPE_STRING;
   _variables[var]._value = vstr;
@@ -1537,13 +2317,13 @@ void Logo::setstringvar(short var, short vstr, short vlen) {
 
 }
 
-short Logo::newdoublevar(short str, short slen, double n) {
+short LogoBase::newdoublevar(short str, short slen, double n) {
 
   if (str < 0) {
     error(LG_OUT_OF_STRINGS);
     return -1;
   }
-  if (_varcount >= MAX_VARS) {
+  if (_varcount >= _maxvars) {
     error(LG_TOO_MANY_VARS);
     return -1;
   }
@@ -1557,20 +2337,20 @@ short Logo::newdoublevar(short str, short slen, double n) {
 
 }
 
-void Logo::setdoublevar(short var, double n) {
+void LogoBase::setdoublevar(short var, double n) {
 
   _variables[var]._type = OPTYPE_INT;
   splitdouble(n, & _variables[var]._value, &_variables[var]._valueopand);
 
 }
 
-short Logo::newlistvar(short str, short slen, const List &l) {
+short LogoBase::newlistvar(short str, short slen, const List &l) {
 
   if (str < 0) {
     error(LG_OUT_OF_STRINGS);
     return -1;
   }
-  if (_varcount >= MAX_VARS) {
+  if (_varcount >= _maxvars) {
     error(LG_TOO_MANY_VARS);
     return -1;
   }
@@ -1585,7 +2365,7 @@ short Logo::newlistvar(short str, short slen, const List &l) {
 
 }
 
-void Logo::setlistvar(short var, const List &l) {
+void LogoBase::setlistvar(short var, const List &l) {
 
   _variables[var]._type = OPTYPE_LIST;
   _variables[var]._value = l.head();
@@ -1593,18 +2373,18 @@ void Logo::setlistvar(short var, const List &l) {
 
 }
 
-bool Logo::varisint(short var) {
+bool LogoBase::varisint(short var) {
   return _variables[var]._type == OPTYPE_INT;
 }
 
-short Logo::varintvalue(short var) {
+short LogoBase::varintvalue(short var) {
   if (varisint(var)) {
     return _variables[var]._value;
   }
   return 0;
 }
 
-bool Logo::getlistval(const ListNodeVal &val, LogoStringResult *str) {
+bool LogoBase::getlistval(const ListNodeVal &val, LogoStringResult *str) {
 
   return parsestring(val.type(), val.data1(), val.data2(), str);
 
@@ -1635,7 +2415,9 @@ bool LogoScheduler::next() {
     return true;
   }
   if (_time == 0) {
-    _provider->delayms(DELAY_TIME);
+    if (_idledelay) {
+      _provider->delayms(DELAY_TIME);
+    }
     return true;
   }
   unsigned long now = _provider->currentms();
@@ -1658,15 +2440,366 @@ bool LogoScheduler::next() {
 
 }
 
+#ifdef USE_PROFILE
+
+void LogoBase::startprofile() {
+
+  for (short i=0; i<MAX_PROFILE_BUILTINS; i++) {
+    _profbuiltins[i]._calls = 0;
+    _profbuiltins[i]._us = 0;
+  }
+  
+  // the first word is always the top level.
+  _profwords[0]._jump = -1;
+  _profwords[0]._steps = 0;
+  _profwords[0]._us = 0;
+  _profwords[0]._calls = 0;
+  _profwordcount = 1;
+  _profcallcount = 0;
+  _profword = -1;
+  _proflast = nowmicros();
+  _profiling = true;
+  
+}
+
+void LogoBase::stopprofile() {
+
+  _profiling = false;
+  
+}
+
+short LogoBase::profileword(short pc) const {
+
+  // words follow the top level code, so it's the closest word start before the pc.
+  short word = 0;
+  for (short i=1; i<_profwordcount; i++) {
+    if (_profwords[i]._jump <= pc && (word == 0 || _profwords[i]._jump > _profwords[word]._jump)) {
+      word = i;
+    }
+  }
+  return word;
+  
+}
+
+short LogoBase::addprofileword(short jump) {
+
+  for (short i=1; i<_profwordcount; i++) {
+    if (_profwords[i]._jump == jump) {
+      return i;
+    }
+  }
+  if (_profwordcount >= MAX_PROFILE_WORDS) {
+    return -1;
+  }
+  short word = _profwordcount;
+  _profwordcount++;
+  _profwords[word]._jump = jump;
+  _profwords[word]._steps = 0;
+  _profwords[word]._us = 0;
+  _profwords[word]._calls = 0;
+  return word;
+  
+}
+
+void LogoBase::profilestep() {
+
+  // the time since the last step goes to the word that step was in.
+  unsigned long now = nowmicros();
+  if (_profword >= 0) {
+    _profwords[_profword]._us += now - _proflast;
+  }
+  _proflast = now;
+  _profword = profileword(_pc);
+  _profwords[_profword]._steps++;
+  
+}
+
+void LogoBase::profilecall(short jump) {
+
+  short to = addprofileword(jump);
+  if (to < 0) {
+    return;
+  }
+  _profwords[to]._calls++;
+  
+  short from = profileword(_pc);
+  for (short i=0; i<_profcallcount; i++) {
+    if (_profcalls[i]._from == from && _profcalls[i]._to == to) {
+      _profcalls[i]._count++;
+      return;
+    }
+  }
+  if (_profcallcount < MAX_PROFILE_CALLS) {
+    _profcalls[_profcallcount]._from = from;
+    _profcalls[_profcallcount]._to = to;
+    _profcalls[_profcallcount]._count = 1;
+    _profcallcount++;
+  }
+  
+}
+
+void LogoBase::profilebuiltin(short index, unsigned long start) {
+
+  if (index < 0 || index >= MAX_PROFILE_BUILTINS) {
+    return;
+  }
+  _profbuiltins[index]._calls++;
+  _profbuiltins[index]._us += nowmicros() - start;
+  
+}
+
+void LogoBase::profilename(short word, const LogoCompilerBase *compiler) {
+
+  if (word == 0) {
+    rawout("(top)");
+    return;
+  }
+  
+  short jump = _profwords[word]._jump;
+  char name[STRING_LEN];
+  
+#ifndef ARDUINO
+  if (compiler && compiler->wordname(jump, name, sizeof(name))) {
+    rawout(name);
+    return;
+  }
+#endif
+
+  // static words are in order with their names first in the fixed strings.
+  if (_staticcode) {
+    short w = 0;
+    for (short i=0; i<_maxcode; i++) {
+      if (instField(i, FIELD_OPTYPE) == SCOPTYPE_WORD) {
+        if (instField(i, FIELD_OP) == jump) {
+          LogoStringResult result;
+          getfixed(&result, w);
+          result.ncpy(name, sizeof(name)-1);
+          rawout(name);
+          return;
+        }
+        w++;
+      }
+    }
+  }
+  
+  rawout("(");
+  rawout((unsigned long)jump);
+  rawout(")");
+  
+}
+
+void LogoBase::printprofile(const LogoCompilerBase *compiler) {
+
+  // make sure the step we are in is counted.
+  if (_profiling && _profword >= 0) {
+    unsigned long now = nowmicros();
+    _profwords[_profword]._us += now - _proflast;
+    _proflast = now;
+  }
+  
+  unsigned long total = 0;
+  for (short i=0; i<_profwordcount; i++) {
+    total += _profwords[i]._steps;
+  }
+  
+  rawout("profile steps ");
+  rawout(total);
+  rawout("\n");
+  
+  // the words with the most steps first.
+  rawout("words:\n");
+  bool done[MAX_PROFILE_WORDS];
+  for (short i=0; i<_profwordcount; i++) {
+    done[i] = false;
+  }
+  for (short i=0; i<_profwordcount; i++) {
+    short word = -1;
+    for (short j=0; j<_profwordcount; j++) {
+      if (!done[j] && (word < 0 || _profwords[j]._steps > _profwords[word]._steps)) {
+        word = j;
+      }
+    }
+    done[word] = true;
+    rawout("  ");
+    profilename(word, compiler);
+    rawout(" steps ");
+    rawout(_profwords[word]._steps);
+    rawout(" (");
+    rawout(total > 0 ? (_profwords[word]._steps * 100) / total : 0);
+    rawout("%) us ");
+    rawout(_profwords[word]._us);
+    rawout(" calls ");
+    rawout(_profwords[word]._calls);
+    rawout("\n");
+  }
+  
+  rawout("builtins:\n");
+  char name[STRING_LEN];
+  for (short i=0; i<MAX_PROFILE_BUILTINS; i++) {
+    if (_profbuiltins[i]._calls == 0) {
+      continue;
+    }
+    LogoStringResult result;
+    if (!getfixedcr(&_corenames, &result, i)) {
+      continue;
+    }
+    result.ncpy(name, sizeof(name)-1);
+    rawout("  ");
+    rawout(name);
+    rawout(" calls ");
+    rawout(_profbuiltins[i]._calls);
+    rawout(" us ");
+    rawout(_profbuiltins[i]._us);
+    rawout("\n");
+  }
+  
+  rawout("calls:\n");
+  for (short i=0; i<_profcallcount; i++) {
+    rawout("  ");
+    profilename(_profcalls[i]._from, compiler);
+    rawout(" -> ");
+    profilename(_profcalls[i]._to, compiler);
+    rawout(" ");
+    rawout(_profcalls[i]._count);
+    rawout("\n");
+  }
+  
+}
+
+#endif // USE_PROFILE
+
+#ifdef USE_TRACE
+
+void LogoBase::starttrace() {
+
+  _tracenext = 0;
+  _tracecount = 0;
+  _tracing = true;
+  
+}
+
+void LogoBase::stoptrace() {
+
+  _tracing = false;
+  
+}
+
+void LogoBase::tracestep() {
+
+  // the oldest entry is just written over.
+  LogoTraceEntry *entry = &_trace[_tracenext];
+  entry->_pc = _pc;
+  entry->_optype = instField(_pc, FIELD_OPTYPE);
+  entry->_tos = _tos;
+  entry->_us = nowmicros();
+  _tracenext++;
+  if (_tracenext >= TRACE_SIZE) {
+    _tracenext = 0;
+  }
+  if (_tracecount < TRACE_SIZE) {
+    _tracecount++;
+  }
+  
+}
+
+void LogoBase::traceentry(short i, unsigned char *buf) const {
+
+  // each entry is the pc (2 bytes), the optype (1 byte), the tos (1 byte) and
+  // the time in microseconds (4 bytes). All little endian.
+  short first = _tracecount < TRACE_SIZE ? 0 : _tracenext;
+  const LogoTraceEntry *entry = &_trace[(first + i) % TRACE_SIZE];
+  buf[0] = entry->_pc & 0xff;
+  buf[1] = (entry->_pc >> 8) & 0xff;
+  buf[2] = entry->_optype;
+  buf[3] = entry->_tos;
+  buf[4] = entry->_us & 0xff;
+  buf[5] = (entry->_us >> 8) & 0xff;
+  buf[6] = (entry->_us >> 16) & 0xff;
+  buf[7] = (entry->_us >> 24) & 0xff;
+  
+}
+
+short LogoBase::tracedump(unsigned char *buf, short len) const {
+
+  // oldest first.
+  short n = 0;
+  for (short i=0; i<_tracecount && n + TRACE_ENTRY_LEN <= len; i++) {
+    traceentry(i, buf + n);
+    n += TRACE_ENTRY_LEN;
+  }
+  return n;
+  
+}
+
+void LogoBase::printtrace() {
+
+  // one entry to a line in hex so it doesn't need a big buffer and it can be 
+  // copied out of a serial monitor.
+  rawout("trace ");
+  rawout((unsigned long)_tracecount);
+  rawout("\n");
+  const char *digits = "0123456789abcdef";
+  for (short i=0; i<_tracecount; i++) {
+    unsigned char entry[TRACE_ENTRY_LEN];
+    traceentry(i, entry);
+    char line[TRACE_ENTRY_LEN * 2 + 2];
+    for (short j=0; j<TRACE_ENTRY_LEN; j++) {
+      line[j*2] = digits[entry[j] >> 4];
+      line[j*2+1] = digits[entry[j] & 0xf];
+    }
+    line[TRACE_ENTRY_LEN * 2] = '\n';
+    line[TRACE_ENTRY_LEN * 2 + 1] = 0;
+    rawout(line);
+  }
+  rawout("end\n");
+  
+}
+
+#endif // USE_TRACE
+
+#if defined(USE_PROFILE) || defined(USE_TRACE)
+
+unsigned long LogoBase::nowmicros() const {
+
+#ifdef ARDUINO
+  return micros();
+#else
+  return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+
+}
+
+void LogoBase::rawout(const char *s) {
+
+#ifdef ARDUINO
+  Serial.print(s);
+#else
+  out() << s;
+#endif
+
+}
+
+void LogoBase::rawout(unsigned long n) {
+
+#ifdef ARDUINO
+  Serial.print(n);
+#else
+  out() << n;
+#endif
+
+}
+
+#endif
+
 #ifndef ARDUINO
 
-void Logo::dumpinstline(short type, short op, short opand, int offset, int line, ostream &str) const {
+void LogoBase::dumpinstline(short type, short op, short opand, int offset, int line, ostream &str) const {
 
   char name[STRING_LEN];
   str << "\t{ ";
   optypename(type, str);
   str << ", ";
-  if (type == OPTYPE_JUMP) {
+  if (type == OPTYPE_JUMP || type == OPTYPE_TAILJUMP) {
     str << op + offset << ", " << opand;
   }
   else if (type == OPTYPE_STRING) {
@@ -1686,19 +2819,32 @@ void Logo::dumpinstline(short type, short op, short opand, int offset, int line,
   
 }
 
-void Logo::dumpinst(LogoCompiler *compiler, const char *varname, ostream &str) const {
+void LogoBase::flashlayout(short *codeend, short *jstart, short *jend) const {
 
   // find the start of the jump code.
-  short jstart = 0;
-  short codeend = 0;
-  while (jstart<CODE_SIZE) {
-    if (!codeend && _code[jstart][FIELD_OPTYPE] == OPTYPE_NOOP) {
-      codeend = jstart;
+  *jstart = 0;
+  *codeend = 0;
+  while (*jstart<_codesize) {
+    if (!*codeend && _code[*jstart][FIELD_OPTYPE] == OPTYPE_NOOP) {
+      *codeend = *jstart;
     }
-    if (_code[jstart++][0] == OPTYPE_HALT) {
+    if (_code[(*jstart)++][0] == OPTYPE_HALT) {
       break;
     }
   }
+  
+  // and the end of it.
+  *jend = *jstart;
+  while (*jend<_codesize && _code[*jend][0] != OPTYPE_NOOP) {
+    (*jend)++;
+  }
+  
+}
+
+void LogoBase::dumpinst(LogoCompilerBase *compiler, const char *varname, ostream &str) const {
+
+  short codeend, jstart, jend;
+  flashlayout(&codeend, &jstart, &jend);
     
   short offset = (codeend + 1) - jstart;
   str << "static const short " << varname << "[][INST_LENGTH] PROGMEM = {" << endl;
@@ -1706,7 +2852,7 @@ void Logo::dumpinst(LogoCompiler *compiler, const char *varname, ostream &str) c
     dumpinstline(_code[i][FIELD_OPTYPE], _code[i][FIELD_OP], _code[i][FIELD_OPAND], offset, i, str);
   }
   str << "\t{ OPTYPE_HALT, 0, 0 },\t\t// " << codeend << endl;
-  for (int i=jstart; _code[i][0] != OPTYPE_NOOP && i<CODE_SIZE; i++) {
+  for (int i=jstart; i<jend; i++) {
     dumpinstline(_code[i][FIELD_OPTYPE], _code[i][FIELD_OP], _code[i][FIELD_OPAND], offset, i + offset, str);
   }
   if (compiler->haswords()) {
@@ -1717,7 +2863,7 @@ void Logo::dumpinst(LogoCompiler *compiler, const char *varname, ostream &str) c
 
 }
 
-bool Logo::safestringcat(short op, short opand, char *buf, int len) const {
+bool LogoBase::safestringcat(short op, short opand, char *buf, int len) const {
 
   LogoStringResult result;
   getstring(&result, op, opand);
@@ -1732,7 +2878,7 @@ bool Logo::safestringcat(short op, short opand, char *buf, int len) const {
   
 }
 
-int Logo::stringslist(LogoCompiler *compiler, char *buf, int len) const {
+int LogoBase::stringslist(LogoCompilerBase *compiler, char *buf, int len) const {
 
   int count = 0;
   int wcount = compiler->wordstringslist(buf, len);
@@ -1746,7 +2892,7 @@ int Logo::stringslist(LogoCompiler *compiler, char *buf, int len) const {
   }
   count += vcount;
   // and add in the ACTUAL strings.
-  for (short i=0; i<CODE_SIZE; i++) {
+  for (short i=0; i<_codesize; i++) {
     if (_code[i][FIELD_OPTYPE] == OPTYPE_STRING) {
       if (!safestringcat(_code[i][FIELD_OP], _code[i][FIELD_OPAND], buf, len)) {
         return -1;
@@ -1759,7 +2905,7 @@ int Logo::stringslist(LogoCompiler *compiler, char *buf, int len) const {
   
 }
 
-void Logo::dumpstringscode(LogoCompiler *compiler, const char *varname, ostream &str) const {
+void LogoBase::dumpstringscode(LogoCompilerBase *compiler, const char *varname, ostream &str) const {
 
   str << "static const char "<< varname << "[] PROGMEM = {" << endl;
   // these are in a particuar order
@@ -1769,7 +2915,7 @@ void Logo::dumpstringscode(LogoCompiler *compiler, const char *varname, ostream
   dumpvarsstrings(compiler, str);
   str << "// strings" << endl;
   char name[STRING_LEN];
-  for (short i=0; i<CODE_SIZE; i++) {
+  for (short i=0; i<_codesize; i++) {
     if (_code[i][FIELD_OPTYPE] == OPTYPE_STRING) {
       LogoStringResult result;
       getstring(&result, _code[i][FIELD_OP], _code[i][FIELD_OPAND]);
@@ -1780,7 +2926,7 @@ void Logo::dumpstringscode(LogoCompiler *compiler, const char *varname, ostream
   str << "};" << endl;
 }
 
-void Logo::optypename(short optype, ostream &str) const {
+void LogoBase::optypename(short optype, ostream &str) const {
 
   switch (optype) {
   case OPTYPE_NOOP:
@@ -1801,6 +2947,9 @@ void Logo::optypename(short optype, ostream &str) const {
   case OPTYPE_JUMP:
     str << "OPTYPE_JUMP";
     break;
+  case OPTYPE_TAILJUMP:
+    str << "OPTYPE_TAILJUMP";
+    break;
   case OPTYPE_STRING:
     str << "OPTYPE_STRING";
     break;
@@ -1810,6 +2959,9 @@ void Logo::optypename(short optype, ostream &str) const {
   case OPTYPE_DOUBLE:
     str << "OPTYPE_DOUBLE";
     break;
+  case OPTYPE_LIST:
+    str << "OPTYPE_LIST";
+    break;
   case OPTYPE_REF:
     str << "OPTYPE_REF";
     break;
@@ -1840,7 +2992,7 @@ void Logo::optypename(short optype, ostream &str) const {
   
 }
 
-void Logo::printvarcode(const LogoVar &var, ostream &str) const {
+void LogoBase::printvarcode(const LogoVar &var, ostream &str) const {
 
   char name[LINE_LEN];
   LogoStringResult result;
@@ -1850,7 +3002,7 @@ void Logo::printvarcode(const LogoVar &var, ostream &str) const {
   
 }
 
-void Logo::dumpvarscode(const LogoCompiler *compiler, ostream &str) const {
+void LogoBase::dumpvarscode(const LogoCompilerBase *compiler, ostream &str) const {
 
   if (!_varcount) {
     return;
@@ -1861,7 +3013,7 @@ void Logo::dumpvarscode(const LogoCompiler *compiler, ostream &str) const {
   }
 }
 
-void Logo::printvarstring(const LogoVar &var, ostream &str) const {
+void LogoBase::printvarstring(const LogoVar &var, ostream &str) const {
 
   char name[LINE_LEN];
   LogoStringResult result;
@@ -1871,7 +3023,7 @@ void Logo::printvarstring(const LogoVar &var, ostream &str) const {
 
 }
 
-void Logo::dumpvarsstrings(const LogoCompiler *compiler, ostream &str) const {
+void LogoBase::dumpvarsstrings(const LogoCompilerBase *compiler, ostream &str) const {
 
   if (!_varcount) {
     return;
@@ -1884,7 +3036,7 @@ void Logo::dumpvarsstrings(const LogoCompiler *compiler, ostream &str) const {
   
 }
 
-int Logo::varstringslist(LogoCompiler *compiler, char *buf, int len) const {
+int LogoBase::varstringslist(LogoCompilerBase *compiler, char *buf, int len) const {
 
   if (!_varcount) {
     return 0;
@@ -1900,7 +3052,7 @@ int Logo::varstringslist(LogoCompiler *compiler, char *buf, int len) const {
   
 }
 
-void Logo::dumpvars(const LogoCompiler *compiler) const {
+void LogoBase::dumpvars(const LogoCompilerBase *compiler) const {
 
   cout << "vars: " << endl;
   
@@ -1918,13 +3070,13 @@ void Logo::dumpvars(const LogoCompiler *compiler) const {
   
 }
 
-void Logo::entab(short indent) const {
+void LogoBase::entab(short indent) const {
   for (short i=0; i<indent; i++) {
     cout << "\t";
   }
 }
 
-void Logo::dump(short indent, short type, short op, short opand) const {
+void LogoBase::dump(short indent, short type, short op, short opand) const {
 
   entab(indent);
   char str[128];
@@ -1946,6 +3098,9 @@ void Logo::dump(short indent, short type, short op, short opand) const {
     case OPTYPE_JUMP:
       cout << "jump " << op;
       break;
+    case OPTYPE_TAILJUMP:
+      cout << "tail jump " << op;
+      break;
     case OPTYPE_STRING:
       getstring(&result, op, opand);
       result.ncpy(str, sizeof(str));
@@ -2004,11 +3159,17 @@ void Logo::dump(short indent, short type, short op, short opand) const {
     case SOPTYPE_GSTART:
       cout << "(stack) gstart ";
       break;
-    case SOPTYPE_OPENLIST:
     case OPTYPE_LIST:
+      {
+        cout << "list ";
+        List l((ListPoolBase *)&_lists, (tNodeType)op, (tNodeType)opand);
+        cout << l.length();
+      }
+      break;
+    case SOPTYPE_OPENLIST:
       {
         cout << "(stack) list ";
-        List l((ListPool *)&_lists, (tNodeType)op, (tNodeType)opand);
+        List l((ListPoolBase *)&_lists, (tNodeType)op, (tNodeType)opand);
         cout << l.length();
       }
       break;
@@ -2021,7 +3182,7 @@ void Logo::dump(short indent, short type, short op, short opand) const {
 
 }
 
-void Logo::printvar(const LogoVar &var) const {
+void LogoBase::printvar(const LogoVar &var) const {
 
   char name[LINE_LEN];
   LogoStringResult result;
@@ -2032,7 +3193,7 @@ void Logo::printvar(const LogoVar &var) const {
   
 }
 
-void Logo::dumpvars() const {
+void LogoBase::dumpvars() const {
 
   cout << "vars: " << endl;
   
@@ -2050,14 +3211,14 @@ void Logo::dumpvars() const {
   
 }
 
-void Logo::dumpstaticwords(const LogoCompiler *compiler) const {
+void LogoBase::dumpstaticwords(const LogoCompilerBase *compiler) const {
 
   if (_staticcode) {
     cout << "static words:" << endl;
 
     char name[STRING_LEN];
     int word = 0;
-    for (short i=0; i<MAX_CODE; i++) {
+    for (short i=0; i<_maxcode; i++) {
       short type = instField(i, FIELD_OPTYPE);
       if (type == SCOPTYPE_WORD) {
         short op = instField(i, FIELD_OP);
@@ -2074,12 +3235,12 @@ void Logo::dumpstaticwords(const LogoCompiler *compiler) const {
   
 }
 
-void Logo::dumpcode(const LogoCompiler *compiler, bool all) const {
+void LogoBase::dumpcode(const LogoCompilerBase *compiler, bool all) const {
 
   if (_staticcode) {
     cout << "static code: pc (" << (short)_pc << ")" << endl;
     
-    for (short i=0; i<MAX_CODE; i++) {
+    for (short i=0; i<_maxcode; i++) {
       short type = instField(i, FIELD_OPTYPE);
       if (type == SCOPTYPE_WORD) {
         break;
@@ -2087,7 +3248,7 @@ void Logo::dumpcode(const LogoCompiler *compiler, bool all) const {
       cout << i;
       short op = instField(i, FIELD_OP);
       short opand = instField(i, FIELD_OPAND);
-      if (type == OPTYPE_JUMP) {
+      if (type == OPTYPE_JUMP || type == OPTYPE_TAILJUMP) {
         entab(1);
         cout << "jump (" << op << ")";
       }
@@ -2099,7 +3260,7 @@ void Logo::dumpcode(const LogoCompiler *compiler, bool all) const {
       }
       mark(i,  _pc, "pc");
       if (all) {
-        mark(i, START_JCODE, "startjcode");
+        mark(i, _startjcode, "startjcode");
         mark(i, _nextjcode, "nextjcode");
       }
       cout << endl;
@@ -2113,7 +3274,7 @@ void Logo::dumpcode(const LogoCompiler *compiler, bool all) const {
     cout << "empty" << endl;
   }
 
-  for (short i=0; i<(all ? MAX_CODE : _nextcode); i++) {
+  for (short i=0; i<(all ? _maxcode : _nextcode); i++) {
     if (compiler) {
       compiler->markword(i);
       compiler->dump(2, instField(i, FIELD_OPTYPE), instField(i, FIELD_OP), instField(i, FIELD_OPAND));
@@ -2124,14 +3285,14 @@ void Logo::dumpcode(const LogoCompiler *compiler, bool all) const {
     }
     mark(i, _pc, "pc");
     if (all) {
-      mark(i, START_JCODE, "startjcode");
+      mark(i, _startjcode, "startjcode");
       mark(i, _nextjcode, "nextjcode");
     }
     cout << endl;
   }
 
   if (!all) {
-    if (_pc >  _nextcode && _pc < START_JCODE) {
+    if (_pc >  _nextcode && _pc < _startjcode) {
       for (short i= _nextcode; i<=_pc; i++) {
        if (compiler) {
           compiler->dump(1, instField(i, FIELD_OPTYPE), instField(i, FIELD_OP), instField(i, FIELD_OPAND));
@@ -2145,7 +3306,7 @@ void Logo::dumpcode(const LogoCompiler *compiler, bool all) const {
       }
     }
     cout << "\t..." << endl;
-    for (short i=START_JCODE; i<_nextjcode; i++) {
+    for (short i=_startjcode; i<_nextjcode; i++) {
       if (compiler) {
         compiler->markword(i);
         compiler->dump(2, instField(i, FIELD_OPTYPE), instField(i, FIELD_OP), instField(i, FIELD_OPAND));
@@ -2155,41 +3316,46 @@ void Logo::dumpcode(const LogoCompiler *compiler, bool all) const {
         dump(1, instField(i, FIELD_OPTYPE), instField(i, FIELD_OP), instField(i, FIELD_OPAND));
       }
       mark(i, _pc, "pc");
-      mark(i, START_JCODE, "startjcode");
+      mark(i, _startjcode, "startjcode");
       cout << endl;
     }
   }
+  
+  if (all && compiler && !_staticcode) {
+    cout << "most stack:" << endl;
+    compiler->stackreport(cout, "\t");
+  }
 
 }
 
-void Logo::mark(short i, short mark, const char *name) const {
+void LogoBase::mark(short i, short mark, const char *name) const {
   if (i == mark) {
     entab(2);
     cout << "(" << name << ")";
   }
 }
 
-ostream &Logo::out() {
+ostream &LogoBase::out() {
   if (_ostream) {
     return *_ostream;
   }
   return cout;
 }
 
-void Logo::setout(ostream *s) {
+void LogoBase::setout(ostream *s) {
   _ostream = s;
 }
 
 
 #endif // !defined(ARDUINO)
 
-void Logo::dumpstack(const LogoCompiler *compiler, bool all) const {
+void LogoBase::dumpstack(const LogoCompilerBase *compiler, bool all) const {
 
 #ifdef ARDUINO
   Serial.print("stack: (");
   Serial.print(_tos);
   Serial.println(")");
-  for (short i=0; i<(all ? MAX_STACK : _tos); i++) {
+  for (short i=0; i<(all ? stacksize() : _tos); i++) {
     Serial.print("\t");
     Serial.print(_stack[i][FIELD_OPTYPE]);
     Serial.print(",");
@@ -2200,7 +3366,7 @@ void Logo::dumpstack(const LogoCompiler *compiler, bool all) const {
 #else
   cout << "stack: (" << _tos << ")" << endl;
   
-  for (short i=0; i<(all ? MAX_STACK : _tos); i++) {
+  for (short i=0; i<(all ? stacksize() : _tos); i++) {
     if (compiler) {
       compiler->dump(1, _stack[i][FIELD_OPTYPE] ,_stack[i][FIELD_OP] ,_stack[i][FIELD_OPAND]);
     }
@@ -66,7 +66,34 @@
 // comment this out.
 #define USE_WIFI
 
-#define USE_JSON
+// count the steps and time spent in each word and builtin (see PROFILE). It costs about 
+// 700 bytes of RAM so it's only on by default off the arduino.
+#ifndef ARDUINO
+#define USE_PROFILE
+#endif
+
+// let words run as tasks alongside the main code (see LAUNCH). Each task has its own
+// stack so it's off for the small AVR boards.
+#if !defined(ARDUINO) || !defined(__AVR__)
+#define USE_TASKS
+#endif
+
+// run words when events come in (see WHEN). They run as tasks so it needs those.
+#ifdef USE_TASKS
+#define USE_EVENTS
+#endif
+
+// compile each new command after the last one and run it after or alongside whatever
+// is running (see LogoCompiler::command). They can run as tasks so it needs those.
+#ifdef USE_TASKS
+#define USE_COMMANDS
+#endif
+
+// record every step in a small ring buffer (see TRACE). It only costs a few cycles each
+// step so turn it on for the arduino to find timing bugs on a device.
+#ifndef ARDUINO
+#define USE_TRACE
+#endif
 
 #ifdef ARDUINO
 
@@ -87,6 +114,16 @@
 // it's really important with these numbers that after you compile your code it 
 // leaves about 200 bytes for local variables. Otherwise your sketch won't work.
 // 
+// Or let the flashcode tool work them out for your program (--config) and put the
+// logoconfig.hpp it writes next to this file.
+
+#if defined(ARDUINO) && defined(__has_include)
+#if __has_include("logoconfig.hpp")
+#include "logoconfig.hpp"
+#endif
+#endif
+
+#ifndef LOGO_SIZED
 
 #ifdef USE_LARGE_CODE
 // Huge settings for something that can handle it.
@@ -154,7 +191,50 @@
 
 #endif // USE_LARGE_CODE
 
-#define NUM_LEN             12        // these number of bytes
+#endif // LOGO_SIZED
+
+// the words the compiler can hold.
+#ifndef MAX_WORDS
+#ifdef USE_LARGE_CODE
+#define MAX_WORDS           1024      // 6 bytes each
+#else
+#define MAX_WORDS           16        // 6 bytes each
+#endif
+#endif
+
+#define NUM_LEN             16        // these number of bytes, -32768.999900
+#ifdef USE_PROFILE
+#define MAX_PROFILE_WORDS   16        // 14 bytes each
+#define MAX_PROFILE_CALLS   16        // 8 bytes each
+#define MAX_PROFILE_BUILTINS 64       // 8 bytes each, more than the number of builtins
+#endif
+
+#ifdef USE_TASKS
+#define MAX_TASKS           3         // including the main code
+#define TASK_QUANTUM        10        // steps before switching to the next task
+#if defined(USE_LARGE_CODE)
+#define TASK_STACK          64        // 6 bytes each
+#elif defined(USE_FLASH_CODE)
+#define TASK_STACK          16        // 6 bytes each
+#else
+#define TASK_STACK          8         // 6 bytes each
+#endif
+#endif
+
+#ifdef USE_EVENTS
+#define MAX_HANDLERS        4         // 6 bytes each
+#endif
+
+#ifdef USE_COMMANDS
+#define MAX_COMMANDS        4         // 4 bytes each, waiting for the main code
+#endif
+
+#ifdef USE_TRACE
+#define TRACE_SIZE          64        // 8 bytes each
+#define TRACE_ENTRY_LEN     8         // bytes in each entry when dumped
+#endif
+
+#define NUM_CACHE_SIZE      4         // 10 to 16 bytes each
 #define SENTENCE_LEN        4         // & and 3 more digits
 #define STRING_LEN          32        // the length of a single string.
 
@@ -169,6 +249,12 @@
 #include <stdio.h>
 #include <math.h>
 
+#include "logowifi.hpp"
+#include "logoio.hpp"
+#ifdef USE_EVENTS
+#include "logoevents.hpp"
+#endif
+
 #ifndef min
 #define min(a,b)            (((a) < (b)) ? (a) : (b))
 #endif
@@ -190,6 +276,10 @@
 #define LG_ARITY_NOT_IMPL     14
 #define LG_EXCEPTION          15
 #define LG_FILE_NOT_FOUND     16
+#define LG_TOO_MANY_TASKS     17
+#define LG_TOKEN_TOO_LONG     18
+#define LG_BAD_IMAGE          19
+#define LG_TOO_MANY_HANDLERS  20
 
 #define OPTYPE_NOOP           0 //
 #define OPTYPE_RETURN         1 //
@@ -210,6 +300,7 @@
 #define OPTYPE_TRY            16 // {
 #define OPTYPE_CATCH          17 // }
 #define OPTYPE_EXCEPTION      18 // &
+#define OPTYPE_TAILJUMP       19 // FIELD_OP = where to jump, a call in tail position that reuses the frame
 
 // only on the stack
 #define SOP_START             100
@@ -228,9 +319,9 @@
 #define SCOPTYPE_VAR          SCOP_START + 2 // FIELD_OP the variable value
 #define SCOPTYPE_END          SCOP_START + 3 // the end of static code.
 
-class Logo;
+class LogoBase;
 
-typedef void (*tLogoFp)(Logo &logo);
+typedef void (*tLogoFp)(LogoBase &logo);
 
 // types are predefinced and small.
 typedef short tStrPool;
@@ -239,13 +330,8 @@ typedef unsigned char tVarType;
 typedef unsigned char tByte;
 
 // allow the code jump to be a char if the code is small.
-#if MAX_CODE <= 256
-typedef unsigned char tJump;
-#define NO_JUMP   255
-#else
-typedef short tJump;
-#define NO_JUMP   -1
-#endif
+typedef LogoIndex<MAX_CODE>::type tJump;
+#define NO_JUMP   ((tJump)LogoIndex<MAX_CODE>::none)
 
 #if defined(ARDUINO) && !defined(__AVR__)
 // this makes it work on the ESP32
@@ -271,6 +357,70 @@ typedef struct {
   short              _valueopand;
 } LogoVar;
 
+typedef struct {
+  tStrPool           _str; // the string in the pool that was parsed
+  tStrPool           _len;
+  short              _int; // what it parsed to as an int
+  double             _double; // and as a double
+} LogoNumCache;
+
+#ifdef USE_PROFILE
+typedef struct {
+  short              _jump; // where the word starts, -1 for the top level
+  unsigned long      _steps;
+  unsigned long      _us;
+  unsigned long      _calls;
+} LogoProfileWord;
+
+typedef struct {
+  short              _from; // index into the profile words
+  short              _to;
+  unsigned long      _count;
+} LogoProfileCall;
+
+typedef struct {
+  unsigned long      _calls;
+  unsigned long      _us;
+} LogoProfileBuiltin;
+#endif
+
+#ifdef USE_TRACE
+typedef struct {
+  unsigned short     _pc;
+  unsigned char      _optype;
+  unsigned char      _tos;
+  unsigned long      _us; // when the step started
+} LogoTraceEntry;
+#endif
+
+#ifdef USE_COMMANDS
+typedef struct {
+  tJump              _start;
+  tJump              _end; // just after its halt, 0 for none
+} LogoCommand;
+#endif
+
+#ifdef USE_TASKS
+typedef struct {
+  bool               _running;
+  tJump              _pc;
+  short              _tos;
+  unsigned long      _lasttime; // the scheduler for its WAIT
+  short              _time;
+#ifdef USE_COMMANDS
+  LogoCommand        _command; // the code it's running that can't be written over
+#endif
+} LogoTask;
+#endif
+
+#ifdef USE_EVENTS
+typedef struct {
+  tStrPool           _name; // the event
+  tStrPool           _namelen;
+  tJump              _jump; // the word
+} LogoHandler;
+#endif
+
 class LogoTimeProvider {
 
 public:
@@ -284,30 +434,55 @@ public:
 class LogoScheduler {
 
 public:
-  LogoScheduler(LogoTimeProvider *provider): _provider(provider), _lasttime(0), _time(0) {}
+  LogoScheduler(LogoTimeProvider *provider): _provider(provider), _lasttime(0), _time(0), _idledelay(true) {}
 
   virtual void schedule(short ms);
   virtual bool next() ;
+  bool waiting() const { return _time != 0; }
+  void setidledelay(bool delay) { _idledelay = delay; }
+  void save(unsigned long *lasttime, short *time) const { *lasttime = _lasttime; *time = _time; }
+  void restore(unsigned long lasttime, short time) { _lasttime = lasttime; _time = time; }
     
 private:
   LogoTimeProvider *_provider;
   unsigned long _lasttime;
   short _time;
+  bool _idledelay; // delay a little between steps when not waiting
 
 };
 
-class LogoCompiler;
+class LogoCompilerBase;
 class ArduinoFlashCode;
 class LogoString;
 class LogoStringResult;
 
 class LogoSketchBase;
 
-class Logo {
+// where a Logo keeps everything and how big each one is (see LogoT).
+typedef struct {
+  tLogoInstruction  *_code;
+  short             _codesize;
+  short             _maxcode;
+  short             _startjcode;
+  tLogoInstruction  *_stack;
+  short             _stacksize;
+#ifdef USE_TASKS
+  tLogoInstruction  *_taskstacks; // MAX_TASKS-1 of them one after the other
+  short             _taskstacksize;
+#endif
+  LogoVar           *_vars;
+  short             _varsize;
+  char              *_strings;
+  short             _stringsize;
+  ListNode          *_nodes;
+  short             _nodesize;
+} LogoStorage;
+
+class LogoBase {
 
 public:
-  Logo(LogoTimeProvider *time=0, LogoString *strings=0, ArduinoFlashCode *code=0);
-  ~Logo();
+  LogoBase(const LogoStorage &storage, LogoTimeProvider *time=0, LogoString *strings=0, ArduinoFlashCode *code=0, LogoIO *io=0);
+  ~LogoBase();
   
   // find any errors in the code.
   short geterr();
@@ -322,11 +497,37 @@ public:
   void resetvars(); // reset the variables
   void fail(short err);
   void schedulenext(short delay);
+  bool waiting() const { return _schedule.waiting(); } // for a WAIT to finish
+  void setidledelay(bool delay) { _schedule.setidledelay(delay); }
   int callword(const char *word); // call a word by name if you know it.
   void halt();
   short pc() { return _pc; }
   void backup() { if (_pc > 0) _pc--; }
   bool call(short jump, tByte opand2);
+  bool tailcall(short jump, tByte arity);
+  
+#ifdef USE_TASKS
+  // tasks
+  bool launch(short jump); // run the word at jump as a task
+  void stoptasks(); // stop all the tasks but the main code
+  short taskcount() const { return _launched; }
+  short currenttask() const { return _task; }
+#endif
+
+#ifdef USE_COMMANDS
+  // commands
+  bool startcommand(short len); // make room after the last command, compile it then...
+  short endcommand(); // run it after or alongside what's running
+  void abandoncommand(); // or throw it away
+  short commandcount() const { return _commandcount; } // waiting to run
+  tJump codelimit() const { return _codelimit; } // the compiler can't go past this
+#endif
+
+#ifdef USE_EVENTS
+  // events
+  bool when(tStrPool name, tStrPool len, short jump); // run the word at jump for the event
+  LogoEventQueue _events; // put them in here
+#endif
   
   // exception handling
   void doThrow();
@@ -337,6 +538,8 @@ public:
   void error(short error);
   void outofcode();
   void addop(tJump *next, short type, short op=0, short opand=0);
+  void marktailcall(tJump last);
+  bool constlist(tJump start, tJump *next);
   short findbuiltin(LogoString *str, short start, short slen);
   short addstring(const LogoString *str, short start, short slen);
   short addstring(LogoStringResult *stri);
@@ -360,6 +563,7 @@ public:
   bool isstackdouble();
 
   short popint();
+  bool popints(short *n1, short *n2);
   void pushint(short n);
   double popdouble();
   void pushdouble(double n);
@@ -370,6 +574,18 @@ public:
   List newlist();
   List poplist();
   bool pop();
+  
+  // how much of everything is being used.
+  short stackdepth() const { return _tos; }
+  short stringsused() const { return _nextstring; }
+  short listsused() const { return _lists.used(); }
+  short codeused() const { return _nextcode + (_nextjcode - _startjcode); }
+  short codesize() const { return _codesize; }
+  short maxcode() const { return _maxcode; }
+  short startjcode() const { return _startjcode; }
+  short maxstack() const { return _maxstack; }
+  short maxvars() const { return _maxvars; }
+  short poolsize() const { return _poolsize; }
   short findvariable(LogoString *str, short start, short slen) const;
   short findvariable(LogoStringResult *str) const;
   short newintvar(short str, short slen, short n);
@@ -379,6 +595,7 @@ public:
   bool isnum(LogoString *str, short wordstart, short wordlen);
   bool getlistval(const ListNodeVal &val, LogoStringResult *str);
   short newstringvar(short str, short slen, short vstr, short vlen);
+  bool intstring(LogoStringResult *str, short *n);
   void setstringvar(short var, short vstr, short vlen);
   short newdoublevar(short str, short slen, double n);
   void setdoublevar(short var, double n);
@@ -394,6 +611,7 @@ public:
   bool codeisint(short rel);
   bool codeisstring(short rel);
   short codetoint(short rel);
+  short codetoword(short rel, short *arity);
   void codetostring(short rel, tStrPool *s, tStrPool *len);
   void jumpskip(short rel);
   void jump(short rel);
@@ -404,28 +622,54 @@ public:
   // allow to be abstracted.
   void callbuiltin(short index);
 
+#ifdef USE_PROFILE
+  // profiling
+  void startprofile();
+  void stopprofile();
+  bool profiling() const { return _profiling; }
+  void printprofile(const LogoCompilerBase *compiler=0);
+#endif
+
+#ifdef USE_TRACE
+  // tracing
+  void starttrace();
+  void stoptrace();
+  bool tracing() const { return _tracing; }
+  short tracecount() const { return _tracecount; }
+  short tracedump(unsigned char *buf, short len) const;
+  void printtrace();
+#endif
+
 #ifdef LOGO_DEBUG
   void outstate() const;
 #endif
  
 #ifndef ARDUINO
   void entab(short indent) const;
-  void dumpcode(const LogoCompiler *compiler, bool all=true) const;
-  void dumpvars(const LogoCompiler *compiler) const;
+  void dumpcode(const LogoCompilerBase *compiler, bool all=true) const;
+  void dumpvars(const LogoCompilerBase *compiler) const;
   void dumpvars() const;
-  void dumpstaticwords(const LogoCompiler *compiler) const;
+  void dumpstaticwords(const LogoCompilerBase *compiler) const;
   bool safestringcat(short op, short opand, char *buf, int len) const;
-  int stringslist(LogoCompiler *compiler, char *buf, int len) const;
-  int varstringslist(LogoCompiler *compiler, char *buf, int len) const;
-  void dumpstringscode(LogoCompiler *compiler, const char *varname, std::ostream &str) const;
-  void dumpinst(LogoCompiler *compiler, const char *varname, std::ostream &str) const;
+  int stringslist(LogoCompilerBase *compiler, char *buf, int len) const;
+  int varstringslist(LogoCompilerBase *compiler, char *buf, int len) const;
+  void dumpstringscode(LogoCompilerBase *compiler, const char *varname, std::ostream &str) const;
+  void dumpinst(LogoCompilerBase *compiler, const char *varname, std::ostream &str) const;
+  void flashlayout(short *codeend, short *jstart, short *jend) const; // where dumpinst puts things
   void dumpinstline(short type, short op, short opand, int offset, int line, std::ostream &str) const;
   void optypename(short optype, std::ostream &str) const;
   void printvarstring(const LogoVar &var, std::ostream &str) const;
-  void dumpvarsstrings(const LogoCompiler *compiler, std::ostream &str) const;
-  void dumpvarscode(const LogoCompiler *compiler, std::ostream &str) const;
+  void dumpvarsstrings(const LogoCompilerBase *compiler, std::ostream &str) const;
+  void dumpvarscode(const LogoCompilerBase *compiler, std::ostream &str) const;
   void printvar(const LogoVar &var) const;
   void printvarcode(const LogoVar &var, std::ostream &str) const;
+  
+  // for writing out an image of the code (see LogoCompiler::writeimage)
+  const char *stringpool() const { return _strings; }
+  const LogoVar &getvar(short var) const { return _variables[var]; }
+  short varcount() const { return _varcount; }
+  short codefield(short pc, short field) const { return _code[pc][field]; }
+  short builtinarity(short op) const { return _corearity[op]; }
   void dump(short indent, short type, short op, short opand) const;
   void mark(short i, short mark, const char *name) const;
   std::ostream &out();
@@ -433,7 +677,7 @@ public:
   std::ostream *_ostream;
 #endif
 
-  void dumpstack(const LogoCompiler *compiler, bool all=true) const;
+  void dumpstack(const LogoCompilerBase *compiler, bool all=true) const;
 
   static const char coreNames[];
   static const char coreArity[];
@@ -441,6 +685,10 @@ public:
   static short findcrstring(const LogoString *strings, const LogoString *stri, short strstart, short slen);
   static bool getfixedcr(const LogoString *strings, LogoStringResult *result, short index);
 
+  // the pins, 0 for the arduino calls (or printing on the host).
+  LogoIO *io() { return _io; }
+  void flushio() { if (_io) _io->flush(); }
+  
   // manage the channel map.
   void setpin(tByte channel, tByte pin) {
     _channels[channel] = pin;
@@ -450,13 +698,15 @@ public:
   }
   LogoSketchBase *_sketch;
   LogoBLEServer _ble;
+  LogoWifi _wifi;
   
 private:
   
   // the pool of all strings
   LogoString *_fixedstrings;
   short _fixedcount;
-  char _strings[STRING_POOL_SIZE];
+  char *_strings;
+  short _poolsize;
   tStrPool _nextstring;
   
   // the core names iand arity.
@@ -465,36 +715,131 @@ private:
   
   // buffer to hold a number conversion
   char _numbuf[NUM_LEN];
+  
+  // strings we have already parsed as numbers
+  LogoNumCache _numcache[NUM_CACHE_SIZE];
+  
+#ifdef USE_PROFILE
+  // the profile
+  bool _profiling;
+  unsigned long _proflast; // when the last step started
+  short _profword; // and the word it was in
+  LogoProfileWord _profwords[MAX_PROFILE_WORDS];
+  short _profwordcount;
+  LogoProfileCall _profcalls[MAX_PROFILE_CALLS];
+  short _profcallcount;
+  LogoProfileBuiltin _profbuiltins[MAX_PROFILE_BUILTINS];
+  
+  short profileword(short pc) const;
+  short addprofileword(short jump);
+  void profilestep();
+  void profilecall(short jump);
+  void profilebuiltin(short index, unsigned long start);
+  void profilename(short word, const LogoCompilerBase *compiler);
+#endif
+
+#ifdef USE_TRACE
+  // the trace
+  bool _tracing;
+  LogoTraceEntry _trace[TRACE_SIZE];
+  short _tracenext; // where the next step goes
+  short _tracecount;
+  
+  void tracestep();
+  void traceentry(short i, unsigned char *buf) const;
+#endif
+
+#if defined(USE_PROFILE) || defined(USE_TRACE)
+  unsigned long nowmicros() const;
+  void rawout(const char *s);
+  void rawout(unsigned long n);
+#endif
    
   // the code
-  tLogoInstruction _code[CODE_SIZE];
+  tLogoInstruction *_code;
+  short _codesize;
+  short _maxcode;
+  short _startjcode;
   tJump _pc;
   ArduinoFlashCode *_staticcode;
   
   // the stack
-  tLogoInstruction _stack[MAX_STACK];
+#ifdef USE_TASKS
+  tLogoInstruction *_mainstack;
+  tLogoInstruction *_stack; // the stack of the running task
+  short _stacksize;
+#else
+  tLogoInstruction *_stack;
+#endif
+  short _maxstack;
   short _tos;
   
+#ifdef USE_TASKS
+  // the tasks, the first is always the main code.
+  LogoTask _tasks[MAX_TASKS];
+  tLogoInstruction *_taskstacks;
+  short _taskstack;
+  short _task; // the running task
+  short _launched; // how many tasks are running apart from the main code
+  short _slice; // steps the running task has had
+  
+  void savetask();
+  void loadtask(short task);
+  void nexttask();
+  void endtask();
+  tJump findhalt() const;
+#endif
+#ifdef USE_COMMANDS
+  LogoCommand _commands[MAX_COMMANDS]; // waiting to run
+  short _commandcount;
+  tJump _commandstart; // the one being compiled, NO_JUMP for none
+  tJump _codelimit; // where it has to stop
+  
+  bool mainidle() const;
+  void runmain(const LogoCommand &cmd);
+  bool runcommand(const LogoCommand &cmd);
+  bool runpending();
+  const LogoCommand *commandinuse(short i) const;
+  tJump commandspace(tJump start) const;
+#endif
+  short stacksize() const;
+  
   // the variables
-  LogoVar _variables[MAX_VARS];
+  LogoVar *_variables;
+  short _maxvars;
   short _varcount;
 
   // Lists
-  ListPool _lists;
+  ListPoolBase _lists;
   
   short getvarfromref(short op, short opand);
   
   // the schdeuler for WAIT
   LogoScheduler _schedule;
   
+#ifdef USE_WIFI_ASYNC
+  bool wifiwaiting(); // the task is waiting for a WIFI word
+#endif
+
+#ifdef USE_EVENTS
+  LogoHandler _handlers[MAX_HANDLERS];
+  short _handlercount;
+  
+  void dispatchevents();
+#endif
+  
   // A channel map for leds
   tByte _channels[8];
   
+  LogoIO *_io;
+  
   short _exception;
   short _exclength;
   
   // parser
   bool parsestring(short type, short op, short oplen, LogoStringResult *str);
+  short formatint(char *buf, long n);
+  short formatdouble(char *buf, short op, short opand);
 
   // fixed strings
   bool fixedcmp(const LogoString *stri, short strstart, short slen, tStrPool str, tStrPool len) const;
@@ -504,6 +849,7 @@ private:
   bool push(short type, short op=0, short opand=0);
   short parseint(short type, short op, short opand);
   double parsedouble(short type, short op, short opand);
+  LogoNumCache *numcache(short str, short len);
   short doreturn();
   short dobuiltin();
   bool doarity();
@@ -522,6 +868,81 @@ private:
    
 };
 
+// the sizes of a Logo from the defines above.
+struct LogoCapacity {
+  static const short code = CODE_SIZE;
+  static const short maxcode = MAX_CODE;
+  static const short startjcode = START_JCODE;
+  static const short stack = MAX_STACK;
+#ifdef USE_TASKS
+  static const short taskstack = TASK_STACK;
+#endif
+  static const short vars = MAX_VARS;
+  static const short strings = STRING_POOL_SIZE;
+  static const short lists = LIST_SIZE;
+  static const short words = MAX_WORDS;
+};
+
+// a Logo with everything it needs inside it. The engine is the same for all
+// of them, this just says how big each part is so you can have two different
+// sized ones in the same sketch:
+//
+//   struct SmallLogo: public LogoCapacity {
+//     static const short code = 40;
+//     static const short maxcode = 40;
+//     static const short startjcode = 20;
+//     static const short stack = 8;
+//   };
+//   LogoT<SmallLogo> logo;
+//
+// The jumps and list nodes are as wide as the biggest MAX_CODE and LIST_SIZE
+// so those have to be big enough for all of them.
+template <class C>
+class LogoT: public LogoBase {
+
+public:
+  LogoT(LogoTimeProvider *time=0, LogoString *strings=0, ArduinoFlashCode *code=0, LogoIO *io=0):
+    LogoBase(storage(), time, strings, code, io) {}
+  
+private:
+  static_assert(sizeof(typename LogoIndex<C::maxcode>::type) <= sizeof(tJump), "make MAX_CODE as big as the biggest Logo");
+  static_assert(sizeof(typename LogoIndex<C::lists>::type) <= sizeof(tNodeType), "make LIST_SIZE as big as the biggest Logo");
+  static_assert(C::startjcode < C::maxcode, "the words have to start inside the code");
+  
+  tLogoInstruction _codestore[C::code];
+  tLogoInstruction _stackstore[C::stack];
+#ifdef USE_TASKS
+  tLogoInstruction _taskstore[(MAX_TASKS-1) * C::taskstack];
+#endif
+  LogoVar _varstore[C::vars];
+  char _stringstore[C::strings];
+  ListNode _nodestore[C::lists];
+  
+  LogoStorage storage() {
+    LogoStorage s;
+    s._code = _codestore;
+    s._codesize = C::code;
+    s._maxcode = C::maxcode;
+    s._startjcode = C::startjcode;
+    s._stack = _stackstore;
+    s._stacksize = C::stack;
+#ifdef USE_TASKS
+    s._taskstacks = _taskstore;
+    s._taskstacksize = C::taskstack;
+#endif
+    s._vars = _varstore;
+    s._varsize = C::vars;
+    s._strings = _stringstore;
+    s._stringsize = C::strings;
+    s._nodes = _nodestore;
+    s._nodesize = C::lists;
+    return s;
+  }
+  
+};
+
+typedef LogoT<LogoCapacity> Logo;
+
 #ifdef LOGO_DEBUG
 #ifdef ARDUINO
 #define DEBUG_DUMP(all)
@@ -21,61 +21,155 @@ using namespace std;
 
 #define COMPILE_UUID  "c807fa87-21a3-47b2-a0f8-9cd1da3407b7"
 #define RUN_UUID      "9de01783-a173-4d85-a7f6-48c7a82c6a63"
+#define IMAGE_UUID    "e3a1c6d2-7b5f-4f0e-9c2a-1d8b6f4e3a57"
 
-bool LogoBLEClient::send(const string &device, const string &data) {
-
-    auto adapter_optional = getAdapter();
+bool LogoSimpleBLETransport::connect() {
 
-    if (!adapter_optional.has_value()) {
-		  cout << "No adapter" << endl;
-      return false;
+  try {
+    _peripheral.connect();
+    
+    // remember where everything is so we don't have to look again.
+    for (auto service : _peripheral.services()) {
+      optional<SimpleBLE::BluetoothUUID> compile;
+      optional<SimpleBLE::BluetoothUUID> run;
+      optional<SimpleBLE::BluetoothUUID> image;
+      for (auto characteristic : service.characteristics()) {
+        if (characteristic.uuid() == COMPILE_UUID) {
+          compile = characteristic.uuid();
+        }
+        else if (characteristic.uuid() == RUN_UUID) {
+          run = characteristic.uuid();
+        }
+        else if (characteristic.uuid() == IMAGE_UUID) {
+          image = characteristic.uuid();
+        }
+      }
+      if (compile && run) {
+        _service = service.uuid();
+        _compile = compile;
+        _run = run;
+        _image = image;
+        return true;
+      }
     }
+  }
+  catch (exception &ex) {
+    cout << "Couldn't connect " << ex.what() << endl;
+    return false;
+  }
+  
+  cout << "Not a Logo device" << endl;
+  _peripheral.disconnect();
+  return false;
+  
+}
 
-    auto adapter = adapter_optional.value();
+void LogoSimpleBLETransport::disconnect() {
 
-    vector<SimpleBLE::Peripheral> peripherals;
+  _peripheral.disconnect();
+  
+}
 
-    adapter.set_callback_on_scan_found([&](SimpleBLE::Peripheral peripheral) { peripherals.push_back(peripheral); });
-    adapter.set_callback_on_scan_start([]() {});
-    adapter.set_callback_on_scan_stop([]() {});    
-    adapter.scan_for(500);
+bool LogoSimpleBLETransport::connected() {
 
-    for (size_t i = 0; i < peripherals.size(); i++) {
-      if (peripherals[i].identifier() == device) {
-        sendToPeripheral(&peripherals[i], data);
-        return true;
-      }
-    }
+  return _service && _peripheral.is_connected();
+  
+}
+
+bool LogoSimpleBLETransport::write(short characteristic, const string &data, bool response) {
 
+  optional<SimpleBLE::BluetoothUUID> uuid = characteristic == BLE_COMPILE ? _compile : characteristic == BLE_IMAGE ? _image : _run;
+  if (!uuid) {
+    cout << "Device can't take an image" << endl;
     return false;
-    
+  }
+  try {
+    if (response) {
+      _peripheral.write_request(*_service, *uuid, data);
+    }
+    else {
+      _peripheral.write_command(*_service, *uuid, data);
+    }
+  }
+  catch (exception &ex) {
+    cout << "Couldn't write " << ex.what() << endl;
+    return false;
+  }
+  return true;
+  
 }
 
-void LogoBLEClient::sendToPeripheral(SimpleBLE::Peripheral *peripheral, const string &contents) {
+bool LogoBLEClient::scan(int ms) {
 
-  peripheral->connect();
-    
-  for (auto service : peripheral->services()) {
-    optional<SimpleBLE::BluetoothUUID> compile;
-    optional<SimpleBLE::BluetoothUUID> run;
-    for (auto characteristic : service.characteristics()) {
-      if (characteristic.uuid() == COMPILE_UUID) {
-        compile = characteristic.uuid();
-      }
-      else if (characteristic.uuid() == RUN_UUID) {
-        run = characteristic.uuid();
+  if (!_adapter) {
+    _adapter = getAdapter();
+    if (!_adapter) {
+      cout << "No adapter" << endl;
+      return false;
+    }
+  }
+  
+  _peripherals.clear();
+  _adapter->set_callback_on_scan_found([&](SimpleBLE::Peripheral peripheral) { _peripherals.push_back(peripheral); });
+  _adapter->set_callback_on_scan_start([]() {});
+  _adapter->set_callback_on_scan_stop([]() {});    
+  _adapter->scan_for(ms);
+  return true;
+  
+}
+
+LogoBLESession *LogoBLEClient::open(const string &device) {
+
+  auto session = _sessions.find(device);
+  if (session != _sessions.end()) {
+    if (!session->second->open()) {
+      return 0;
+    }
+    return session->second.get();
+  }
+  
+  // only scan if we haven't seen it.
+  for (int tries=0; tries<2; tries++) {
+    for (auto p : _peripherals) {
+      if (p.identifier() == device) {
+        LogoSimpleBLETransport *transport = new LogoSimpleBLETransport(p);
+        _transports[device] = unique_ptr<LogoSimpleBLETransport>(transport);
+        LogoBLESession *s = new LogoBLESession(transport);
+        _sessions[device] = unique_ptr<LogoBLESession>(s);
+        if (!s->open()) {
+          return 0;
+        }
+        return s;
       }
     }
-    if (compile && run) {
-      cout << "Sending code" << endl;
-      peripheral->write_request(service.uuid(), *run, "RESETCODE");
-      peripheral->write_request(service.uuid(), *compile, contents);
-      peripheral->write_request(service.uuid(), *run, "RESTART");
-      break;
+    if (tries == 0 && !scan()) {
+      return 0;
     }
   }
   
-  peripheral->disconnect();
+  return 0;
+  
+}
+
+void LogoBLEClient::close() {
+
+  // the sessions first since they use the transports.
+  _sessions.clear();
+  _transports.clear();
+  
+}
+
+bool LogoBLEClient::send(const string &device, const string &data) {
+
+  LogoBLESession *session = open(device);
+  if (!session) {
+    return false;
+  }
+  cout << "Sending code" << endl;
+  bool ok = session->sendcode(data);
+  session->close();
+  return ok;
+  
 }
 
 optional<SimpleBLE::Adapter> LogoBLEClient::getAdapter() {
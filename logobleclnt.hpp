@@ -17,8 +17,34 @@
 #define H_logobleclnt
 
 #ifndef ARDUINO
+#include "logoblesession.hpp"
+
 #include <optional>
+#include <vector>
+#include <map>
+#include <memory>
 #include <simpleble/SimpleBLE.h>
+
+// the radio, the characteristics are found once when we connect.
+class LogoSimpleBLETransport: public LogoBLETransport {
+
+public:
+  LogoSimpleBLETransport(SimpleBLE::Peripheral peripheral): _peripheral(peripheral) {}
+  
+  // LogoBLETransport
+  virtual bool connect();
+  virtual void disconnect();
+  virtual bool connected();
+  virtual bool write(short characteristic, const std::string &data, bool response);
+
+private:
+  SimpleBLE::Peripheral _peripheral;
+  std::optional<SimpleBLE::BluetoothUUID> _service;
+  std::optional<SimpleBLE::BluetoothUUID> _compile;
+  std::optional<SimpleBLE::BluetoothUUID> _run;
+  std::optional<SimpleBLE::BluetoothUUID> _image; // older devices don't have it
+  
+};
 #endif
 
 class LogoBLEClient {
@@ -26,13 +52,25 @@ class LogoBLEClient {
 public:
 
 #ifndef ARDUINO
+  // connect, send the code and disconnect.
   bool send(const std::string &device, const std::string &data);
+  
+  // find all the devices that are around.
+  bool scan(int ms=500);
+  
+  // a session with a device that stays connected until close. 
+  LogoBLESession *open(const std::string &device);
+  void close();
 #endif
   
 private:
 
 #ifndef ARDUINO
-  void sendToPeripheral(SimpleBLE::Peripheral *peripheral, const std::string &contents);
+  std::optional<SimpleBLE::Adapter> _adapter;
+  std::vector<SimpleBLE::Peripheral> _peripherals;
+  std::map<std::string, std::unique_ptr<LogoSimpleBLETransport> > _transports;
+  std::map<std::string, std::unique_ptr<LogoBLESession> > _sessions;
+  
   std::optional<SimpleBLE::Adapter> getAdapter();
 #endif
 
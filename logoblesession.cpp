@@ -0,0 +1,163 @@
+/*
+  logoblesession.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 19-Oct-2026
+
+  This work is licensed under the Creative Commons Attribution 4.0 International License.
+  To view a copy of this license, visit http://creativecommons.org/licenses/by/4.0/ or
+  send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+  https://github.com/visualopsholdings/tinylogo
+*/
+
+#include "logoblesession.hpp"
+
+#ifndef ARDUINO
+
+#include "logo.hpp"
+#include "logocompiler.hpp"
+
+using namespace std;
+
+LogoBLESession::LogoBLESession(LogoBLETransport *transport, short window):
+  _transport(transport), _window(window < 1 ? 1 : window), _unacked(0),
+  _writes(0), _requests(0), _bytes(0) {
+}
+
+LogoBLESession::~LogoBLESession() {
+
+  close();
+
+}
+
+bool LogoBLESession::open() {
+
+  if (_transport->connected()) {
+    return true;
+  }
+  _unacked = 0;
+  return _transport->connect();
+
+}
+
+void LogoBLESession::close() {
+
+  if (_transport->connected()) {
+    _transport->disconnect();
+  }
+
+}
+
+bool LogoBLESession::write(short characteristic, const string &data, bool response) {
+
+  // the writes without a response just go out as fast as the radio can take them
+  // but every so often we wait so the device doesn't get too far behind.
+  _unacked++;
+  if (_unacked >= _window) {
+    response = true;
+  }
+  if (response) {
+    _unacked = 0;
+    _requests++;
+  }
+  _writes++;
+  _bytes += data.size();
+  return _transport->write(characteristic, data, response);
+
+}
+
+bool LogoBLESession::sendcode(const string &code) {
+
+  if (!write(BLE_RUN, "RESETCODE")) {
+    return false;
+  }
+  for (size_t i=0; i<code.size(); i+=BLE_CHUNK_LEN) {
+    if (!write(BLE_COMPILE, code.substr(i, BLE_CHUNK_LEN))) {
+      return false;
+    }
+  }
+  // this finishes off the compile too.
+  return write(BLE_RUN, "RESTART", true);
+
+}
+
+bool LogoBLESession::sendimage(const string &image) {
+
+  for (size_t i=0; i<image.size(); i+=BLE_CHUNK_LEN) {
+    if (!write(BLE_IMAGE, image.substr(i, BLE_CHUNK_LEN))) {
+      return false;
+    }
+  }
+  return write(BLE_RUN, "RESTART", true);
+
+}
+
+bool LogoBLESession::command(const string &cmd) {
+
+  return write(BLE_RUN, cmd);
+
+}
+
+bool LogoBLESession::sync() {
+
+  if (_unacked == 0) {
+    return true;
+  }
+  // an empty command does nothing but still has to wait for all the others.
+  return write(BLE_RUN, "", true);
+
+}
+
+LogoBLELoopback::LogoBLELoopback(LogoBase *logo, LogoCompilerBase *compiler):
+  _logo(logo), _compiler(compiler), _connected(false), _roundtrips(0) {
+}
+
+bool LogoBLELoopback::connect() {
+
+  _connected = true;
+  return true;
+
+}
+
+void LogoBLELoopback::disconnect() {
+
+  _connected = false;
+
+}
+
+bool LogoBLELoopback::write(short characteristic, const string &data, bool response) {
+
+  if (!_connected) {
+    return false;
+  }
+  if (response) {
+    _roundtrips++;
+  }
+
+  // just like the compile and image characteristics.
+  if (characteristic == BLE_COMPILE) {
+    _compiler->feed(data.c_str(), data.size());
+    return true;
+  }
+  if (characteristic == BLE_IMAGE) {
+    _compiler->feedimage(data.c_str(), data.size());
+    return true;
+  }
+
+  // and the run one.
+  _compiler->flush();
+  if (data == "RESTART") {
+    _logo->restart();
+  }
+  else if (data == "RESETCODE") {
+    _logo->resetcode();
+  }
+  else if (data == "RESET") {
+    _logo->reset();
+  }
+  return true;
+
+}
+
+#endif // ARDUINO
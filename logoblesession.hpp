@@ -0,0 +1,120 @@
+/*
+  logoblesession.hpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 19-Oct-2026
+
+  Tiniest Logo Intepreter BLE session. This stays connected to a device and
+  sends it code and commands without waiting for each write.
+
+  The writes go through a transport so it can be the real radio (see logobleclnt.hpp)
+  or a loopback straight into a Logo for testing.
+
+  This work is licensed under the Creative Commons Attribution 4.0 International License.
+  To view a copy of this license, visit http://creativecommons.org/licenses/by/4.0/ or
+  send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+  https://github.com/visualopsholdings/tinylogo
+*/
+
+#ifndef H_logoblesession
+#define H_logoblesession
+
+#ifndef ARDUINO
+
+#include <string>
+
+class LogoBase;
+class LogoCompilerBase;
+
+// the code is sent in pieces this big and the device compiles them as they come in.
+#define BLE_CHUNK_LEN       20
+
+// how many writes we send without a response before waiting for one.
+#define BLE_WINDOW          8
+
+// the characteristics we write to.
+#define BLE_COMPILE         0
+#define BLE_RUN             1
+#define BLE_IMAGE           2
+
+class LogoBLETransport {
+
+public:
+  virtual ~LogoBLETransport() {}
+
+  virtual bool connect() = 0;
+  virtual void disconnect() = 0;
+  virtual bool connected() = 0;
+
+  // write to one of the characteristics, waiting for a response or not.
+  virtual bool write(short characteristic, const std::string &data, bool response) = 0;
+
+};
+
+class LogoBLESession {
+
+public:
+  LogoBLESession(LogoBLETransport *transport, short window=BLE_WINDOW);
+  ~LogoBLESession();
+
+  bool open();
+  void close();
+  bool isopen() { return _transport->connected(); }
+
+  // replace the code and run it.
+  bool sendcode(const std::string &code);
+
+  // replace everything with an image compiled here (see LogoCompiler::writeimage) and run it.
+  bool sendimage(const std::string &image);
+
+  // send to the run characteristic (RESTART, TRACE etc)
+  bool command(const std::string &cmd);
+
+  // finish off the writes so far and wait for the device to have them.
+  bool sync();
+
+  // how many writes and how many of them waited for a response.
+  long writes() const { return _writes; }
+  long requests() const { return _requests; }
+  long bytes() const { return _bytes; }
+
+private:
+  LogoBLETransport *_transport;
+  short _window;
+  short _unacked;
+  long _writes;
+  long _requests;
+  long _bytes;
+
+  bool write(short characteristic, const std::string &data, bool response=false);
+
+};
+
+// a device that is just a Logo on this machine, it does what the bluetooth
+// server does with each write.
+class LogoBLELoopback: public LogoBLETransport {
+
+public:
+  LogoBLELoopback(LogoBase *logo, LogoCompilerBase *compiler);
+
+  // LogoBLETransport
+  virtual bool connect();
+  virtual void disconnect();
+  virtual bool connected() { return _connected; }
+  virtual bool write(short characteristic, const std::string &data, bool response);
+
+  // how many times we had to wait for the device.
+  long roundtrips() const { return _roundtrips; }
+
+private:
+  LogoBase *_logo;
+  LogoCompilerBase *_compiler;
+  bool _connected;
+  long _roundtrips;
+
+};
+
+#endif // ARDUINO
+
+#endif // H_logoblesession
@@ -47,7 +47,7 @@ void LogoBLEServer::loop() {
 class MyServerCallbacks: public BLEServerCallbacks {
 
 public:
-  MyServerCallbacks(Logo *logo): _logo(logo) {}
+  MyServerCallbacks(LogoBase *logo): _logo(logo) {}
   
   // BLEServerCallbacks
   void onConnect(BLEServer* pServer) {
@@ -59,7 +59,7 @@ public:
   }
   
 private:
-  Logo *_logo;
+  LogoBase *_logo;
 };
 
 class CompileCharCallbacks: public BLECharacteristicCallbacks {
@@ -70,9 +70,29 @@ public:
   // BLECharacteristicCallbacks
   void onWrite(BLECharacteristic *pCharacteristic) {
   
+    // the writes are only as big as the MTU so they can split a program
+    // anywhere, even in the middle of a token.
     string val = pCharacteristic->getValue();
-    Serial.println(val.c_str());
-    _sketch->docompile(val.c_str());
+    Serial.print(val.c_str());
+    _sketch->dofeed(val.c_str(), val.length());
+    
+  }
+  
+private:
+  LogoSketchBase *_sketch;
+};
+
+class ImageCharCallbacks: public BLECharacteristicCallbacks {
+
+public:
+  ImageCharCallbacks(LogoSketchBase *sketch): _sketch(sketch) {}
+  
+  // BLECharacteristicCallbacks
+  void onWrite(BLECharacteristic *pCharacteristic) {
+  
+    // code that was already compiled on the host, it's loaded as it comes in.
+    string val = pCharacteristic->getValue();
+    _sketch->doimage(val.c_str(), val.length());
     
   }
   
@@ -83,11 +103,14 @@ private:
 class RunCharCallbacks: public BLECharacteristicCallbacks {
 
 public:
-  RunCharCallbacks(Logo *logo): _logo(logo) {}
+  RunCharCallbacks(LogoBase *logo, LogoSketchBase *sketch): _logo(logo), _sketch(sketch) {}
   
   // BLECharacteristicCallbacks
   void onWrite(BLECharacteristic *pCharacteristic) {
   
+    // anything that was being compiled is finished.
+    _sketch->doflush();
+    
     string val = pCharacteristic->getValue();
     Serial.println(val.c_str());
     if (val == "RESTART") {
@@ -99,18 +122,29 @@ public:
     else if (val == "RESET") {
       _logo->reset();
     }
+#ifdef USE_TRACE
+    else if (val == "TRACE") {
+      // snapshot the trace so it can be read from the trace characteristic.
+      static unsigned char buf[TRACE_SIZE * TRACE_ENTRY_LEN];
+      short len = _logo->tracedump(buf, sizeof(buf));
+      _logo->_ble._bttracechar->setValue(buf, len);
+    }
+#endif
      
   }
   
 private:
-  Logo *_logo;
+  LogoBase *_logo;
+  LogoSketchBase *_sketch;
 };
 #endif
 
 #define COMPILE_UUID  "c807fa87-21a3-47b2-a0f8-9cd1da3407b7"
 #define RUN_UUID      "9de01783-a173-4d85-a7f6-48c7a82c6a63"
+#define TRACE_UUID    "5b3f2a6e-0c41-4e8a-9d47-2f6c1b8e7a90"
+#define IMAGE_UUID    "e3a1c6d2-7b5f-4f0e-9c2a-1d8b6f4e3a57"
 
-void LogoBLEServer::start(Logo *logo, LogoSketchBase *sketch, const char *sname, const char *suid) {
+void LogoBLEServer::start(LogoBase *logo, LogoSketchBase *sketch, const char *sname, const char *suid) {
 
 #if defined(ESP32) && defined(USE_BT)
   // Create the BLE Device
@@ -125,15 +159,25 @@ void LogoBLEServer::start(Logo *logo, LogoSketchBase *sketch, const char *sname,
 
   // Create a BLE Characteristic for the compiler
   _btcompilechar = service->createCharacteristic(COMPILE_UUID,
-                    BLECharacteristic::PROPERTY_WRITE);
+                    BLECharacteristic::PROPERTY_WRITE | BLECharacteristic::PROPERTY_WRITE_NR);
 
   _btcompilechar->setCallbacks(new CompileCharCallbacks(sketch));
 
   // Create a BLE Characteristic for the runtime
   _btrunchar = service->createCharacteristic(RUN_UUID,
-                    BLECharacteristic::PROPERTY_WRITE);
+                    BLECharacteristic::PROPERTY_WRITE | BLECharacteristic::PROPERTY_WRITE_NR);
+
+  _btrunchar->setCallbacks(new RunCharCallbacks(logo, sketch));
+
+  // Create a BLE Characteristic for compiled code
+  _btimagechar = service->createCharacteristic(IMAGE_UUID,
+                    BLECharacteristic::PROPERTY_WRITE | BLECharacteristic::PROPERTY_WRITE_NR);
+
+  _btimagechar->setCallbacks(new ImageCharCallbacks(sketch));
 
-  _btrunchar->setCallbacks(new RunCharCallbacks(logo));
+  // Create a BLE Characteristic to read the trace from
+  _bttracechar = service->createCharacteristic(TRACE_UUID,
+                    BLECharacteristic::PROPERTY_READ);
 
   // Start the service
   service->start();
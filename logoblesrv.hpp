@@ -26,14 +26,14 @@ class BLECharacteristic;
 #endif
 #endif
 
-class Logo;
+class LogoBase;
 class LogoSketchBase;
 
 class LogoBLEServer {
 
 public:
 
-  void start(Logo *logo, LogoSketchBase *sketch, const char *sname, const char *suid);
+  void start(LogoBase *logo, LogoSketchBase *sketch, const char *sname, const char *suid);
   void loop();
 
 #ifdef ARDUINO
@@ -41,6 +41,8 @@ public:
   BLEServer* _btserver = 0;
   BLECharacteristic* _btcompilechar = 0;
   BLECharacteristic* _btrunchar = 0;
+  BLECharacteristic* _btimagechar = 0;
+  BLECharacteristic* _bttracechar = 0;
   bool _btconnected = false;
   bool _btoldconnected = false;
 #endif
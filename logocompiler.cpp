@@ -18,7 +18,7 @@
 #include "arduinodebug.hpp"
 #else
 #include "test/debug.hpp"
-void LogoCompiler::outstate() const {
+void LogoCompilerBase::outstate() const {
   cout << endl;
 }
 #endif // ARDUINO
@@ -29,6 +29,7 @@ void LogoCompiler::outstate() const {
 #ifndef ARDUINO
 #include <iostream>
 #include <sstream>
+#include <set>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 using namespace std;
@@ -40,22 +41,36 @@ namespace fs = boost::filesystem;
 #include <ctype.h>
 #include <math.h>
 
-LogoCompiler::LogoCompiler(Logo * logo) :
+LogoCompilerBase::LogoCompilerBase(LogoBase * logo, LogoWord *words, short maxwords) :
   _logo(logo),
   _inword(false), _inwordargs(false), _defining(-1), _defininglen(-1), _wordarity(-1),
   _jump(NO_JUMP),
-  _wordcount(0) {
+  _liststart(NO_JUMP), _listdepth(0), _constlists(true),
+  _tokenlen(0), _feedstate(FEED_LINE),
+  _imgsection(IMAGE_DONE),
+  _wordcount(0), _words(words), _maxwords(maxwords) {
+#ifndef ARDUINO
+  _leaveout = 0;
+  _leavingout = false;
+#endif
 }
 
-void LogoCompiler::reset() {
+void LogoCompilerBase::reset() {
 
   DEBUG_IN(LogoCompiler, "reset");
   
   _wordcount = 0;
+  _liststart = NO_JUMP;
+  _listdepth = 0;
+  _tokenlen = 0;
+  _feedstate = FEED_LINE;
+#ifndef ARDUINO
+  _leavingout = false;
+#endif
   
 }
 
-int LogoCompiler::callword(const char *word) {
+int LogoCompilerBase::callword(const char *word) {
 
   DEBUG_IN_ARGS(LogoCompiler, "callword", "%s", word);
   
@@ -72,7 +87,7 @@ int LogoCompiler::callword(const char *word) {
 
 }
 
-void LogoCompiler::compileword(tJump *next, LogoString *stri, short wordstart, short wordlen, short op) {
+void LogoCompilerBase::compileword(tJump *next, LogoString *stri, short wordstart, short wordlen, short op) {
 
   DEBUG_IN_ARGS(LogoCompiler, "compileword", "%i%i%i", wordstart, wordlen, op);
 
@@ -84,7 +99,7 @@ void LogoCompiler::compileword(tJump *next, LogoString *stri, short wordstart, s
     return;
   }
     
-  if (*next >= MAX_CODE) {
+  if (*next >= _logo->maxcode()) {
     _logo->outofcode();
     DEBUG_RETURN(" err ", 0);
     return;
@@ -100,10 +115,24 @@ void LogoCompiler::compileword(tJump *next, LogoString *stri, short wordstart, s
     DEBUG_RETURN(" gend ", 0);
     return;
   case '[':
+    if (_listdepth == 0) {
+      _liststart = *next;
+    }
+    _listdepth++;
     _logo->addop(next, OPTYPE_LSTART);
     DEBUG_RETURN(" lstart ", 0);
     return;
   case ']':
+    if (_listdepth > 0) {
+      _listdepth--;
+    }
+    // a list of just literals can be built once now rather than every time it's run.
+    if (_listdepth == 0 && _constlists && _liststart != NO_JUMP && _logo->constlist(_liststart, next)) {
+      _liststart = NO_JUMP;
+      DEBUG_RETURN(" const list ", 0);
+      return;
+    }
+    _liststart = NO_JUMP;
     _logo->addop(next, OPTYPE_LEND);
     DEBUG_RETURN(" lstart ", 0);
     return;
@@ -136,6 +165,13 @@ void LogoCompiler::compileword(tJump *next, LogoString *stri, short wordstart, s
     return;
   }
 
+  // the word we are defining isn't in the words yet but can call itself.
+  if (_defining >= 0 && _jump != NO_JUMP && _logo->stringcmp(stri, wordstart, wordlen, _defining, _defininglen)) {
+   _logo->addop(next, OPTYPE_JUMP, _jump, _wordarity);
+    DEBUG_RETURN(" recursive word ", 0);
+    return;
+  }
+
   if ((*stri)[wordstart] == ':') {
     short len = wordlen - 1;
     short str = _logo->addstring(stri, wordstart+1, len);
@@ -178,7 +214,7 @@ void LogoCompiler::compileword(tJump *next, LogoString *stri, short wordstart, s
 
 }
 
-short LogoCompiler::findword(LogoString *str, short wordstart, short wordlen) const {
+short LogoCompilerBase::findword(LogoString *str, short wordstart, short wordlen) const {
 
   for (short i=0; i<_wordcount; i++) {
     if (_logo->stringcmp(str, wordstart, wordlen, _words[i]._name, _words[i]._namelen)) {
@@ -189,7 +225,7 @@ short LogoCompiler::findword(LogoString *str, short wordstart, short wordlen) co
   return -1;
 }
 
-short LogoCompiler::findword(LogoStringResult *str) const {
+short LogoCompilerBase::findword(LogoStringResult *str) const {
 
   for (short i=0; i<_wordcount; i++) {
     if (_logo->stringcmp(str, _words[i]._name, _words[i]._namelen)) {
@@ -200,13 +236,22 @@ short LogoCompiler::findword(LogoStringResult *str) const {
   return -1;
 }
 
-void LogoCompiler::finishword(short word, short wordlen, short jump, short arity) {
+void LogoCompilerBase::finishword(short word, short wordlen, short jump, short arity) {
 
   DEBUG_IN_ARGS(LogoCompiler, "finishword", "%i%i%i%i", word, wordlen, jump, arity);
   
+  // if the last thing we do is call another word, let it return for us.
+  if (jump != NO_JUMP && _logo->_nextjcode > jump) {
+    _logo->marktailcall(_logo->_nextjcode - 1);
+  }
+  
+  if (_logo->_nextjcode >= _logo->maxcode()) {
+    _logo->outofcode();
+    return;
+  }
   _logo->addop(&_logo->_nextjcode, OPTYPE_RETURN);
       
-  if (_wordcount >= MAX_WORDS) {
+  if (_wordcount >= _maxwords) {
     _logo->error(LG_TOO_MANY_WORDS);
     return;
   }
@@ -220,35 +265,42 @@ void LogoCompiler::finishword(short word, short wordlen, short jump, short arity
 }
 
 
-void LogoCompiler::compile(LogoString *str) {
+void LogoCompilerBase::compile(LogoString *str) {
 
   DEBUG_IN(LogoCompiler, "compile");
   
   short len = str->length();
-  short nextline = 0;
-  short linestart, linelen;
-  while (nextline >= 0) {
-    nextline = scan(&linestart, &linelen, str, len, nextline, true);
-    
-    if (linelen == 0) {
-      break;
-    }
-#ifdef LOGO_DEBUG  
-    str->dump("line", linestart, linelen);
-#endif
+  for (short i=0; i<len; i++) {
+    feed((*str)[i]);
+  }
+  flush();
 
-    // skip comments.
-    if ((*str)[linestart] == '#') {
-      DEBUG_OUT(" comment", 0);
-      continue;
+}
+
+int LogoCompilerBase::command(const char *cmd) {
+
+  DEBUG_IN(LogoCompiler, "command");
+  
+#ifdef USE_COMMANDS
+  if (_logo->startcommand(strlen(cmd))) {
+    compile(cmd);
+    short err = _logo->geterr();
+    if (err) {
+      _logo->abandoncommand();
+      return err;
     }
-    
-    compilewords(str, linestart, linelen, true);
+    return _logo->endcommand();
   }
+  // everything is in use so start again.
+  _logo->stoptasks();
+#endif
+  _logo->resetcode();
+  compile(cmd);
+  return _logo->geterr();
 
 }
 
-void LogoCompiler::compilewords(LogoString *str, short start, short len, bool define) {
+void LogoCompilerBase::compilewords(LogoString *str, short start, short len, bool define) {
 
   DEBUG_IN_ARGS(LogoCompiler, "compilewords", "%i%i%b", start, len, define);
   
@@ -262,16 +314,12 @@ void LogoCompiler::compilewords(LogoString *str, short start, short len, bool de
   
     nextword = scan(&wordstart, &wordlen, str, start+len, nextword, false);
     if (define) {
-      if (!dodefine(str, wordstart, wordlen, nextword == -1)) {
-        if (_logo->_nextcode >= START_JCODE) {
-          _logo->outofcode();
-          return;
-        }
-        compileword(&_logo->_nextcode, str, wordstart, wordlen, 0);
+      if (!compiletoken(str, wordstart, wordlen, nextword == -1)) {
+        return;
       }
     }
     else {
-      if (_logo->_nextjcode >= MAX_CODE) {
+      if (_logo->_nextjcode >= _logo->maxcode()) {
         _logo->outofcode();
         return;
       }
@@ -281,7 +329,324 @@ void LogoCompiler::compilewords(LogoString *str, short start, short len, bool de
   
 }
 
-bool LogoCompiler::dodefine(LogoString *str, short wordstart, short wordlen, bool eol) {
+bool LogoCompilerBase::compiletoken(LogoString *str, short wordstart, short wordlen, bool eol) {
+
+  if (dodefine(str, wordstart, wordlen, eol)) {
+    return true;
+  }
+#ifdef USE_COMMANDS
+  if (_logo->_nextcode >= _logo->codelimit()) {
+#else
+  if (_logo->_nextcode >= _logo->startjcode()) {
+#endif
+    _logo->outofcode();
+    return false;
+  }
+  compileword(&_logo->_nextcode, str, wordstart, wordlen, 0);
+  return true;
+  
+}
+
+void LogoCompilerBase::feed(const char *code, short len) {
+
+  DEBUG_IN_ARGS(LogoCompiler, "feed", "%i", len);
+  
+  for (short i=0; i<len; i++) {
+    feed(code[i]);
+  }
+  
+}
+
+void LogoCompilerBase::feed(char c) {
+
+  if (c == 0) {
+    return;
+  }
+  
+  // this is the same as scan() but a character at a time.
+  bool eol = c == '\n' || c == ';';
+  
+  switch (_feedstate) {
+  
+  case FEED_COMMENT:
+    if (eol) {
+      _feedstate = FEED_LINE;
+    }
+    return;
+    
+  case FEED_ESCAPE:
+    if (eol) {
+      flush();
+      return;
+    }
+    _feedstate = FEED_QUOTE;
+    break;
+    
+  case FEED_QUOTE:
+    if (eol) {
+      flush();
+      return;
+    }
+    // we leave the opening quote in but not the closing one.
+    if (c == '\"' || isspace(c)) {
+      _feedstate = FEED_DONE;
+      return;
+    }
+    if (c == '\\') {
+      _feedstate = FEED_ESCAPE;
+    }
+    break;
+    
+  case FEED_WORD:
+    if (eol) {
+      flush();
+      return;
+    }
+    if (switchtoken(_token[0], c, false)) {
+      if (isspace(c)) {
+        _feedstate = FEED_DONE;
+        return;
+      }
+      // this character starts the next token.
+      feedtoken(false);
+      _tokenlen = 0;
+      _feedstate = c == '\"' ? FEED_QUOTE : FEED_WORD;
+    }
+    break;
+    
+  default:
+    if (eol) {
+      flush();
+      return;
+    }
+    if (isspace(c)) {
+      return;
+    }
+    if (_feedstate == FEED_LINE && c == '#') {
+      _feedstate = FEED_COMMENT;
+      return;
+    }
+    if (_feedstate == FEED_DONE) {
+      feedtoken(false);
+    }
+    _tokenlen = 0;
+    _feedstate = c == '\"' ? FEED_QUOTE : FEED_WORD;
+    break;
+  }
+  
+  if (_tokenlen >= TOKEN_LEN) {
+    // only once for each token.
+    if (_tokenlen == TOKEN_LEN) {
+      _logo->error(LG_TOKEN_TOO_LONG);
+      _tokenlen++;
+    }
+    return;
+  }
+  _token[_tokenlen++] = c;
+  
+}
+
+void LogoCompilerBase::flush() {
+
+  DEBUG_IN(LogoCompiler, "flush");
+  
+  if (_feedstate != FEED_LINE && _feedstate != FEED_COMMENT) {
+    feedtoken(true);
+  }
+  _feedstate = FEED_LINE;
+  
+  // an image that didn't all arrive.
+  if (_imgsection != IMAGE_DONE && _imgsection != IMAGE_ERR) {
+    imageerror(LG_BAD_IMAGE);
+  }
+  _imgsection = IMAGE_DONE;
+  
+}
+
+void LogoCompilerBase::feedtoken(bool eol) {
+
+  if (_tokenlen > TOKEN_LEN) {
+    // too long and we already have the error.
+    return;
+  }
+  LogoSimpleString str(_token, _tokenlen);
+  compiletoken(&str, 0, _tokenlen, eol);
+
+}
+
+void LogoCompilerBase::feedimage(const char *data, short len) {
+
+  DEBUG_IN_ARGS(LogoCompiler, "feedimage", "%i", len);
+  
+  for (short i=0; i<len; i++) {
+    imagebyte(data[i]);
+  }
+  
+}
+
+void LogoCompilerBase::imagebyte(tByte b) {
+
+  if (_imgsection == IMAGE_ERR) {
+    return;
+  }
+  
+  if (_imgsection == IMAGE_DONE) {
+    // the start of the next one.
+    _imgsum1 = 0;
+    _imgsum2 = 0;
+    imagesection(IMAGE_HEADER);
+  }
+  
+  if (_imgsection != IMAGE_SUM) {
+    _imgsum1 = (_imgsum1 + b) % 255;
+    _imgsum2 = (_imgsum2 + _imgsum1) % 255;
+  }
+  
+  // the strings are just bytes, collect them in the token so we can add them
+  // to the pool a few at a time.
+  if (_imgsection == IMAGE_STRINGS) {
+    _token[_tokenlen++] = b;
+    _imgcount--;
+    if (_tokenlen == TOKEN_LEN || _imgcount == 0) {
+      imagestrings();
+    }
+    if (_imgcount == 0 && _imgsection != IMAGE_ERR) {
+      imagesection(IMAGE_VARS);
+    }
+    return;
+  }
+  
+  // everything else is shorts.
+  static const tByte itemlen[] = { IMAGE_HEADER_LEN, 0, 2, 3, 3, 4, 1 };
+  short *item = _imgsection == IMAGE_HEADER ? _imghead : _imgitem;
+  if (_imgbytes % 2) {
+    item[_imgbytes / 2] |= b << 8;
+  }
+  else {
+    item[_imgbytes / 2] = b;
+  }
+  _imgbytes++;
+  if (_imgbytes == itemlen[_imgsection] * 2) {
+    _imgbytes = 0;
+    imageitem();
+  }
+  
+}
+
+void LogoCompilerBase::imageitem() {
+
+  switch (_imgsection) {
+  
+  case IMAGE_HEADER:
+    if (_imghead[0] != IMAGE_MAGIC || _imghead[1] != IMAGE_VERSION) {
+      imageerror(LG_BAD_IMAGE);
+      return;
+    }
+    for (short i=2; i<IMAGE_HEADER_LEN; i++) {
+      if (_imghead[i] < 0) {
+        imageerror(LG_BAD_IMAGE);
+        return;
+      }
+    }
+    // make sure it will all fit before we throw away what we have.
+    if (_imghead[2] >= _logo->poolsize()) {
+      imageerror(LG_OUT_OF_STRINGS);
+      return;
+    }
+    if (_imghead[3] > _logo->maxvars()) {
+      imageerror(LG_TOO_MANY_VARS);
+      return;
+    }
+    if (_imghead[4] >= _logo->startjcode() || _logo->startjcode() + _imghead[5] > _logo->maxcode()) {
+      imageerror(LG_OUT_OF_CODE);
+      return;
+    }
+    if (_imghead[6] > _maxwords) {
+      imageerror(LG_TOO_MANY_WORDS);
+      return;
+    }
+    _logo->reset();
+    reset();
+    imagesection(IMAGE_STRINGS);
+    return;
+    
+  case IMAGE_VARS:
+    if (_logo->newintvar(_imgitem[0], _imgitem[1], 0) < 0) {
+      imageerror(LG_TOO_MANY_VARS);
+      return;
+    }
+    break;
+    
+  case IMAGE_TOP:
+  case IMAGE_WORDCODE:
+    if (_imgitem[0] == OPTYPE_JUMP || _imgitem[0] == OPTYPE_TAILJUMP) {
+      _imgitem[1] += _logo->startjcode();
+    }
+    _logo->addop(_imgsection == IMAGE_TOP ? &_logo->_nextcode : &_logo->_nextjcode, _imgitem[0], _imgitem[1], _imgitem[2]);
+    break;
+    
+  case IMAGE_WORDS:
+    _words[_wordcount]._name = _imgitem[0];
+    _words[_wordcount]._namelen = _imgitem[1];
+    _words[_wordcount]._jump = _imgitem[2] < 0 ? NO_JUMP : _imgitem[2] + _logo->startjcode();
+    _words[_wordcount]._arity = _imgitem[3];
+    _wordcount++;
+    break;
+    
+  case IMAGE_SUM:
+    if ((unsigned short)_imgitem[0] != ((_imgsum2 << 8) | _imgsum1)) {
+      imageerror(LG_BAD_IMAGE);
+      return;
+    }
+    _imgsection = IMAGE_DONE;
+    return;
+  }
+  
+  _imgcount--;
+  if (_imgcount == 0) {
+    imagesection(_imgsection + 1);
+  }
+  
+}
+
+void LogoCompilerBase::imagesection(tByte section) {
+
+  _imgsection = section;
+  _imgbytes = 0;
+  if (section == IMAGE_HEADER || section == IMAGE_SUM) {
+    _imgcount = 1;
+    return;
+  }
+  if (section == IMAGE_STRINGS) {
+    _tokenlen = 0;
+  }
+  
+  // the counts are in the header in the same order as the sections.
+  _imgcount = _imghead[section + 1];
+  if (_imgcount == 0) {
+    imagesection(section + 1);
+  }
+
+}
+
+void LogoCompilerBase::imagestrings() {
+
+  LogoSimpleString str(_token, _tokenlen);
+  if (_logo->addstring(&str, 0, _tokenlen) < 0) {
+    imageerror(LG_OUT_OF_STRINGS);
+  }
+  _tokenlen = 0;
+  
+}
+
+void LogoCompilerBase::imageerror(short err) {
+
+  _logo->error(err);
+  _imgsection = IMAGE_ERR;
+
+}
+
+bool LogoCompilerBase::dodefine(LogoString *str, short wordstart, short wordlen, bool eol) {
 
   DEBUG_IN_ARGS(LogoCompiler, "dodefine", "%i%i%b%b%b", wordstart, wordlen, _inword, _inwordargs, eol);
   
@@ -294,6 +659,16 @@ bool LogoCompiler::dodefine(LogoString *str, short wordstart, short wordlen, boo
     return false;
   }
   
+#ifndef ARDUINO
+  if (_leavingout) {
+    // nothing until the END of the word.
+    if (str->ncasecmp("END", wordstart, wordlen) == 0) {
+      _leavingout = false;
+    }
+    return true;
+  }
+#endif
+
   if (str->ncasecmp("TO", wordstart, wordlen) == 0) {
     _inword = true;
     _inwordargs = false;
@@ -312,6 +687,19 @@ bool LogoCompiler::dodefine(LogoString *str, short wordstart, short wordlen, boo
   
     if (_defining < 0) {
   
+#ifndef ARDUINO
+      if (_leaveout && wordlen < LINE_LEN) {
+        char name[LINE_LEN];
+        str->ncpy(name, wordstart, wordlen);
+        if (_leaveout->find(to_upper_copy(string(name))) != _leaveout->end()) {
+          _inword = false;
+          _inwordargs = false;
+          _leavingout = true;
+          DEBUG_RETURN(" left out %b", true);
+          return true;
+        }
+      }
+#endif
       _defininglen = wordlen;
       _defining = _logo->addstring(str, wordstart, wordlen);
       if (_defining < 0) {
@@ -344,7 +732,7 @@ bool LogoCompiler::dodefine(LogoString *str, short wordstart, short wordlen, boo
     _jump = _logo->_nextjcode;
   }
   
-  if (_logo->_nextjcode >= MAX_CODE) {
+  if (_logo->_nextjcode >= _logo->maxcode()) {
     _logo->outofcode();
     return true;
   }
@@ -377,7 +765,7 @@ bool LogoCompiler::dodefine(LogoString *str, short wordstart, short wordlen, boo
 
 }
 
-bool LogoCompiler::switchtoken(char prevc, char c, bool newline) {
+bool LogoCompilerBase::switchtoken(char prevc, char c, bool newline) {
 
 //  DEBUG_IN_ARGS(Logo, "switchtoken", "%c%b%b", c, newline, wasident);
   
@@ -396,7 +784,7 @@ bool LogoCompiler::switchtoken(char prevc, char c, bool newline) {
   
 }
 
-short LogoCompiler::scan(short *strstart, short *strsize, LogoString *str, short len, short start, bool newline) {
+short LogoCompilerBase::scan(short *strstart, short *strsize, LogoString *str, short len, short start, bool newline) {
 
   DEBUG_IN_ARGS(LogoCompiler, "scan", "%i%i%b", start, len, newline);
   
@@ -491,7 +879,7 @@ short LogoCompiler::scan(short *strstart, short *strsize, LogoString *str, short
 
 #ifndef ARDUINO
 
-void LogoCompiler::dumpwordscode(short offset, ostream &str) const {
+void LogoCompilerBase::dumpwordscode(short offset, ostream &str) const {
 
   if (!_wordcount) {
     return;
@@ -509,13 +897,13 @@ void LogoCompiler::dumpwordscode(short offset, ostream &str) const {
   
 }
 
-void LogoCompiler::entab(short indent) const {
+void LogoCompilerBase::entab(short indent) const {
   for (short i=0; i<indent; i++) {
     cout << "\t";
   }
 }
 
-void LogoCompiler::printwordstring(const LogoWord &word, ostream &str) const {
+void LogoCompilerBase::printwordstring(const LogoWord &word, ostream &str) const {
   char name[LINE_LEN];
   LogoStringResult result;
   _logo->getstring(&result, word._name, word._namelen);
@@ -523,7 +911,7 @@ void LogoCompiler::printwordstring(const LogoWord &word, ostream &str) const {
   str << "\t\"" << name << "\\n\"";
 }
 
-void LogoCompiler::dumpwordstrings(ostream &str) const {
+void LogoCompilerBase::dumpwordstrings(ostream &str) const {
 
   if (!_wordcount) {
     return;
@@ -536,7 +924,7 @@ void LogoCompiler::dumpwordstrings(ostream &str) const {
   
 }
 
-int LogoCompiler::wordstringslist(char *buf, int len) const {
+int LogoCompilerBase::wordstringslist(char *buf, int len) const {
 
   if (!_wordcount) {
     return 0;
@@ -552,7 +940,7 @@ int LogoCompiler::wordstringslist(char *buf, int len) const {
   
 }
 
-int LogoCompiler::inlinelgo(std::fstream &file, const std::map<std::string, std::string> &directives, std::ostream &str) {
+int LogoCompilerBase::inlinelgo(std::fstream &file, const std::map<std::string, std::string> &directives, std::ostream &str) {
 
   // check for name directive
   map<string, string>::const_iterator name = directives.find("NAME");
@@ -577,7 +965,7 @@ int LogoCompiler::inlinelgo(std::fstream &file, const std::map<std::string, std:
   
 }
 
-int LogoCompiler::inlinefile(std::fstream &file, std::ostream &str) {
+int LogoCompilerBase::inlinefile(std::fstream &file, std::ostream &str) {
 
   file.clear();
   file.seekg(0, ios::beg);
@@ -592,7 +980,7 @@ int LogoCompiler::inlinefile(std::fstream &file, std::ostream &str) {
   
 }
 
-int LogoCompiler::compilefn(const std::string &name, const std::map<std::string, std::string> &directives, bool autoassign) {
+int LogoCompilerBase::compilefn(const std::string &name, const std::map<std::string, std::string> &directives, bool autoassign) {
 
   fstream file;
   file.open(name, ios::in);
@@ -605,7 +993,60 @@ int LogoCompiler::compilefn(const std::string &name, const std::map<std::string,
   
 }
 
-int LogoCompiler::compile(fstream &file, const map<string, string> &directives, bool autoassign) {
+static void putshort(string *image, short n) {
+  image->push_back(n & 0xff);
+  image->push_back((n >> 8) & 0xff);
+}
+
+static void putinst(string *image, short start, short optype, short op, short opand) {
+  if (optype == OPTYPE_JUMP || optype == OPTYPE_TAILJUMP) {
+    op -= start;
+  }
+  putshort(image, optype);
+  putshort(image, op);
+  putshort(image, opand);
+}
+
+void LogoCompilerBase::writeimage(string *image) const {
+
+  // lists in the pool aren't in the image, so compile with setconstlists(false)
+  // just like for flash code.
+  putshort(image, IMAGE_MAGIC);
+  putshort(image, IMAGE_VERSION);
+  putshort(image, _logo->stringsused());
+  putshort(image, _logo->varcount());
+  putshort(image, _logo->_nextcode);
+  putshort(image, _logo->_nextjcode - _logo->startjcode());
+  putshort(image, _wordcount);
+  image->append(_logo->stringpool(), _logo->stringsused());
+  for (short i=0; i<_logo->varcount(); i++) {
+    putshort(image, _logo->getvar(i)._name);
+    putshort(image, _logo->getvar(i)._namelen);
+  }
+  for (short i=0; i<_logo->_nextcode; i++) {
+    putinst(image, _logo->startjcode(), _logo->codefield(i, FIELD_OPTYPE), _logo->codefield(i, FIELD_OP), _logo->codefield(i, FIELD_OPAND));
+  }
+  for (short i=_logo->startjcode(); i<_logo->_nextjcode; i++) {
+    putinst(image, _logo->startjcode(), _logo->codefield(i, FIELD_OPTYPE), _logo->codefield(i, FIELD_OP), _logo->codefield(i, FIELD_OPAND));
+  }
+  for (short i=0; i<_wordcount; i++) {
+    putshort(image, _words[i]._name);
+    putshort(image, _words[i]._namelen);
+    putshort(image, _words[i]._jump == NO_JUMP ? -1 : _words[i]._jump - _logo->startjcode());
+    putshort(image, _words[i]._arity);
+  }
+  
+  unsigned short sum1 = 0;
+  unsigned short sum2 = 0;
+  for (auto c: *image) {
+    sum1 = (sum1 + (unsigned char)c) % 255;
+    sum2 = (sum2 + sum1) % 255;
+  }
+  putshort(image, (sum2 << 8) | sum1);
+  
+}
+
+int LogoCompilerBase::compile(fstream &file, const map<string, string> &directives, bool autoassign) {
 
   file.clear();
   file.seekg(0, ios::beg);
@@ -625,7 +1066,7 @@ int LogoCompiler::compile(fstream &file, const map<string, string> &directives,
   
 }
 
-int LogoCompiler::generatecode(fstream &file, const map<string, string> &directives, ostream &str) {
+int LogoCompilerBase::generatecode(fstream &file, const map<string, string> &directives, ostream &str, LogoSizes *sizes) {
 
   // check for name directive
   map<string, string>::const_iterator name = directives.find("NAME");
@@ -633,10 +1074,36 @@ int LogoCompiler::generatecode(fstream &file, const map<string, string> &directi
     return LG_OUT_OF_STRINGS;
   }
   
+  // with a COMMANDS directive (the words that can be called from the serial port) only
+  // those, SETUP and what they and the code at the top use are kept.
+  set<string> dead;
+  map<string, string>::const_iterator commands = directives.find("COMMANDS");
+  if (commands != directives.end()) {
+    Logo logo;
+    LogoCompiler compiler(&logo);
+    compiler.setconstlists(false);
+    compiler.compile(file, directives);
+    int err = logo.geterr();
+    if (err) {
+      return err;
+    }
+    vector<string> names;
+    split(names, commands->second, is_any_of(","));
+    set<string> roots;
+    for (vector<string>::iterator i=names.begin(); i != names.end(); i++) {
+      roots.insert(to_upper_copy(trim_copy(*i)));
+    }
+    roots.insert("SETUP");
+    compiler.deadwords(roots, &dead);
+  }
+  
   // first compile the code so we can dump the strings from it in 
   // the correct order
+  // lists in the pool aren't in flash so leave them to be built when they run.
   Logo logo;
   LogoCompiler compiler(&logo);
+  compiler.setconstlists(false);
+  compiler.leaveout(&dead);
   compiler.compile(file, directives);
 //  compiler.dump(false);
   int err = logo.geterr();
@@ -660,6 +1127,8 @@ int LogoCompiler::generatecode(fstream &file, const map<string, string> &directi
     // build a new engine with these strings and compile again.
     Logo logo2(0, &strings);
     LogoCompiler compiler2(&logo2);
+    compiler2.setconstlists(false);
+    compiler2.leaveout(&dead);
     compiler2.compile(file, directives);
     int err = logo2.geterr();
     if (err) {
@@ -668,13 +1137,28 @@ int LogoCompiler::generatecode(fstream &file, const map<string, string> &directi
     
     // ready to dump the code now.
     logo2.dumpinst(&compiler2, ("code_" + name->second).c_str(), str);
+    str << "// the most stack each word can use" << endl;
+    compiler2.stackreport(str, "//   ");
+    if (!dead.empty()) {
+      str << "// left out because nothing calls them:";
+      for (set<string>::iterator i=dead.begin(); i != dead.end(); i++) {
+        str << " " << *i;
+      }
+      str << endl;
+    }
+    
+    if (sizes) {
+      LogoSizes more;
+      compiler2.measure(&more);
+      growsizes(sizes, more);
+    }
   }
   
   return 0;
   
 }
 
-int LogoCompiler::includelgo(const string &infn, const map<string, string> &directives, fstream &outfile) {
+int LogoCompilerBase::includelgo(const string &infn, const map<string, string> &directives, fstream &outfile, LogoSizes *sizes) {
 
   fstream file;
   file.open(infn, ios::in);
@@ -690,14 +1174,14 @@ int LogoCompiler::includelgo(const string &infn, const map<string, string> &dire
   if (inl != directives.end() && inl->second == "true") {
     map<string, string>::const_iterator name = directives.find("NAME");
     if (name == directives.end()) {
-      err = LogoCompiler::inlinefile(file, str);
+      err = LogoCompilerBase::inlinefile(file, str);
     }
     else {
-      err = LogoCompiler::inlinelgo(file, directives, str);
+      err = LogoCompilerBase::inlinelgo(file, directives, str);
     }
   }
   else {
-    err = LogoCompiler::generatecode(file, directives, str);
+    err = LogoCompilerBase::generatecode(file, directives, str, sizes);
   }
   
   file.close();
@@ -711,7 +1195,7 @@ int LogoCompiler::includelgo(const string &infn, const map<string, string> &dire
   
 }
 
-void LogoCompiler::getdirectives(const string line, map<string, string> *directives) {
+void LogoCompilerBase::getdirectives(const string line, map<string, string> *directives) {
   
   directives->clear();
   
@@ -737,7 +1221,7 @@ void LogoCompiler::getdirectives(const string line, map<string, string> *directi
   
 }
 
-void LogoCompiler::replacedirectives(string *line, const map<string, string> &directives, bool autoassign, int *count) {
+void LogoCompilerBase::replacedirectives(string *line, const map<string, string> &directives, bool autoassign, int *count) {
 
   while (1) {
     size_t dollar = line->find('$');
@@ -772,7 +1256,7 @@ void LogoCompiler::replacedirectives(string *line, const map<string, string> &di
 
 }
 
-int LogoCompiler::updateino(const std::string &infn, std::fstream &infile, std::fstream &outfile) {
+int LogoCompilerBase::updateino(const std::string &infn, std::fstream &infile, std::fstream &outfile, LogoSizes *sizes) {
 
   const string logo_directive = "//#LOGO";
 
@@ -794,7 +1278,7 @@ int LogoCompiler::updateino(const std::string &infn, std::fstream &infile, std::
         including = true;
         outfile << line << endl;
         cout << "including " << incpath.string() << endl;
-        int err = includelgo(incpath.string(), directives, outfile);
+        int err = includelgo(incpath.string(), directives, outfile, sizes);
         if (err) {
           return err;
         }
@@ -821,7 +1305,445 @@ int LogoCompiler::updateino(const std::string &infn, std::fstream &infile, std::
 
 }
 
-void LogoCompiler::printword(const LogoWord &word) const {
+void LogoCompilerBase::measure(LogoSizes *sizes) const {
+
+  // laid out just like the flash code.
+  short codeend, jstart, jend;
+  _logo->flashlayout(&codeend, &jstart, &jend);
+  sizes->_jcode = codeend + 1;
+  sizes->_code = sizes->_jcode + (jend - jstart) + 1;
+  if (_wordcount) {
+    sizes->_code += _wordcount + _logo->varcount();
+  }
+  
+  sizes->_strings = _logo->stringsused();
+  sizes->_words = _wordcount;
+  
+  // the arguments are there already, a MAKE adds one when it runs.
+  set<string> vars;
+  char name[LINE_LEN];
+  for (short i=0; i<_logo->varcount(); i++) {
+    LogoStringResult result;
+    _logo->getstring(&result, _logo->getvar(i)._name, _logo->getvar(i)._namelen);
+    result.ncpy(name, sizeof(name));
+    vars.insert(name);
+  }
+  LogoSimpleString make("MAKE");
+  short makeop = _logo->findbuiltin(&make, 0, make.length());
+  for (short i=0; i<_logo->codesize()-1; i++) {
+    if (_logo->codefield(i, FIELD_OPTYPE) == OPTYPE_BUILTIN && _logo->codefield(i, FIELD_OP) == makeop &&
+        _logo->codefield(i+1, FIELD_OPTYPE) == OPTYPE_STRING) {
+      LogoStringResult result;
+      _logo->getstring(&result, _logo->codefield(i+1, FIELD_OP), _logo->codefield(i+1, FIELD_OPAND));
+      result.ncpy(name, sizeof(name));
+      vars.insert(name);
+    }
+  }
+  sizes->_vars = vars.size();
+
+  // everything inside a list could end up in a node.
+  sizes->_lists = 0;
+  short depth = 0;
+  for (short i=0; i<_logo->codesize(); i++) {
+    short type = _logo->codefield(i, FIELD_OPTYPE);
+    if (type == OPTYPE_LEND) {
+      depth--;
+      continue;
+    }
+    if (depth > 0) {
+      sizes->_lists++;
+    }
+    if (type == OPTYPE_LSTART) {
+      depth++;
+    }
+  }
+  
+  // the code at the top and any word could be called.
+  sizes->_stack = stackdepth(0);
+  for (short i=0; i<_wordcount && sizes->_stack >= 0; i++) {
+    if (_words[i]._jump == NO_JUMP) {
+      continue;
+    }
+    short depth = stackdepth(_words[i]._jump);
+    sizes->_stack = depth < 0 ? -1 : max(sizes->_stack, depth);
+  }
+  
+}
+
+void LogoCompilerBase::growsizes(LogoSizes *sizes, const LogoSizes &more) {
+
+  sizes->_code = max(sizes->_code, more._code);
+  sizes->_jcode = max(sizes->_jcode, more._jcode);
+  sizes->_strings = max(sizes->_strings, more._strings);
+  sizes->_vars = max(sizes->_vars, more._vars);
+  sizes->_words = max(sizes->_words, more._words);
+  sizes->_lists = max(sizes->_lists, more._lists);
+  if (sizes->_stack >= 0) {
+    sizes->_stack = more._stack < 0 ? -1 : max(sizes->_stack, more._stack);
+  }
+  
+}
+
+#define CONFIG_STRING_SPARE   32  // for the strings it makes when it runs
+#define CONFIG_STACK_SPARE    2   // for calling a word from the serial port
+
+static void configline(const char *name, short value, const string &comment, ostream &str) {
+  str << "#define " << name << string(max(1, 20 - (int)strlen(name)), ' ') << value;
+  if (!comment.empty()) {
+    str << string(max(1, 10 - (int)to_string(value).length()), ' ') << "// " << comment;
+  }
+  str << endl;
+}
+
+void LogoCompilerBase::writeconfig(const LogoSizes &sizes, const string &name, ostream &str) {
+
+  str << "/*" << endl;
+  str << "  logoconfig.hpp" << endl;
+  str << endl;
+  str << "  Written by flashcode for " << name << ". Put it next to logo.hpp and the arrays" << endl;
+  str << "  will be just big enough for this program." << endl;
+  str << "*/" << endl;
+  str << endl;
+  str << "#ifndef H_logoconfig" << endl;
+  str << "#define H_logoconfig" << endl;
+  str << endl;
+  str << "#define LOGO_SIZED" << endl;
+  str << endl;
+  configline("STRING_POOL_SIZE", sizes._strings + CONFIG_STRING_SPARE, to_string(sizes._strings) + " when compiled", str);
+  configline("MAX_CODE", sizes._code, "the flash code", str);
+  configline("START_JCODE", sizes._jcode, "where the words start in it", str);
+  str << "#if defined(ARDUINO) && defined(__AVR__)" << endl;
+  configline("CODE_SIZE", 2, "", str);
+  str << "#else" << endl;
+  str << "#define CODE_SIZE           MAX_CODE" << endl;
+  str << "#endif" << endl;
+  if (sizes._stack < 0) {
+    configline("MAX_STACK", 64, "a word calls itself so this is just a guess", str);
+  }
+  else {
+    configline("MAX_STACK", sizes._stack + CONFIG_STACK_SPARE, "at most " + to_string(sizes._stack) + " when it runs", str);
+  }
+  configline("MAX_VARS", max((short)1, sizes._vars), "", str);
+  configline("MAX_WORDS", max((short)1, sizes._words), "", str);
+  configline("LIST_SIZE", max((short)1, sizes._lists), "", str);
+  str << endl;
+  str << "#endif // H_logoconfig" << endl;
+
+}
+
+// something waiting on the stack. A builtin or word waiting for its arguments or
+// a list or group (that needs nothing) that everything inside it stays in.
+typedef struct {
+  short     _base; // the stack before it
+  short     _need; // arguments still to come
+  tJump     _word; // called when they have, NO_JUMP for a builtin
+} LogoPending;
+
+short LogoCompilerBase::stackdepth(tJump pc, vector<tJump> *cycle) const {
+
+  map<tJump, short> depths;
+  vector<tJump> path;
+  return stackdepth(pc, &depths, &path, cycle);
+  
+}
+
+short LogoCompilerBase::stackdepth(tJump start, map<tJump, short> *depths, vector<tJump> *path, vector<tJump> *cycle) const {
+
+  map<tJump, short>::const_iterator done = depths->find(start);
+  if (done != depths->end()) {
+    return done->second;
+  }
+  vector<tJump>::iterator again = find(path->begin(), path->end(), start);
+  if (again != path->end()) {
+    // back to a word we are still in.
+    if (cycle && cycle->empty()) {
+      cycle->assign(again, path->end());
+      cycle->push_back(start);
+    }
+    return -1;
+  }
+  
+  // a word starts with its return address and arguments.
+  short tos = 0;
+  if (start >= _logo->startjcode()) {
+    tos = 1;
+    for (short i=0; i<_wordcount; i++) {
+      if (_words[i]._jump == start) {
+        tos += _words[i]._arity;
+        break;
+      }
+    }
+  }
+  short peak = tos;
+  bool bounded = true;
+  vector<LogoPending> pending;
+  path->push_back(start);
+  
+  for (short pc=start; bounded && pc<_logo->codesize(); pc++) {
+  
+    short type = _logo->codefield(pc, FIELD_OPTYPE);
+    if (type == OPTYPE_RETURN || type == OPTYPE_HALT || type == OPTYPE_NOOP) {
+      break;
+    }
+    short op = _logo->codefield(pc, FIELD_OP);
+    
+    // something was left for whatever is waiting.
+    bool value = false;
+    
+    switch (type) {
+    
+    case OPTYPE_POPREF:
+      // an argument.
+      if (tos > 0) {
+        tos--;
+      }
+      break;
+      
+    case OPTYPE_STRING:
+    case OPTYPE_INT:
+    case OPTYPE_DOUBLE:
+    case OPTYPE_REF:
+    case OPTYPE_LIST:
+    case OPTYPE_EXCEPTION:
+      tos++;
+      value = true;
+      break;
+      
+    case OPTYPE_LSTART:
+    case OPTYPE_GSTART:
+      pending.push_back({ tos, 0, NO_JUMP });
+      // a list might be code for a FOREVER, REPEAT or IF to run.
+      tos += type == OPTYPE_LSTART ? 2 : 1;
+      break;
+      
+    case OPTYPE_LEND:
+    case OPTYPE_GEND:
+      while (!pending.empty()) {
+        LogoPending p = pending.back();
+        pending.pop_back();
+        if (p._need == 0) {
+          tos = p._base;
+          break;
+        }
+      }
+      tos++;
+      value = true;
+      break;
+      
+    case OPTYPE_TRY:
+      tos++;
+      break;
+      
+    case OPTYPE_CATCH:
+      if (tos > 0) {
+        tos--;
+      }
+      break;
+      
+    case OPTYPE_BUILTIN:
+      {
+        short arity = _logo->builtinarity(op);
+        if (arity == INFIX_ARITY) {
+          // it takes what's on the top.
+          pending.push_back({ (short)(tos - 1), 1, NO_JUMP });
+          tos++;
+        }
+        else if (arity > 0) {
+          pending.push_back({ tos, arity, NO_JUMP });
+          tos++;
+        }
+        else if (!pending.empty()) {
+          tos++;
+          value = true;
+        }
+      }
+      break;
+      
+    case OPTYPE_JUMP:
+    case OPTYPE_TAILJUMP:
+      {
+        if (op == NO_JUMP) {
+          // a word that was never defined does nothing.
+          break;
+        }
+        short arity = _logo->codefield(pc, FIELD_OPAND);
+        if (arity > 0) {
+          pending.push_back({ tos, arity, (tJump)op });
+          tos++;
+          break;
+        }
+        if (type == OPTYPE_TAILJUMP && op == start && tos == 1 && pending.empty()) {
+          // it goes round again in the same frame.
+          break;
+        }
+        short depth = stackdepth(op, depths, path, cycle);
+        if (depth < 0) {
+          bounded = false;
+          break;
+        }
+        peak = max(peak, (short)(tos + depth));
+        if (!pending.empty()) {
+          tos++;
+          value = true;
+        }
+      }
+      break;
+      
+    }
+    
+    peak = max(peak, tos);
+    
+    // give the value to what's waiting for it.
+    while (value && bounded && !pending.empty() && pending.back()._need > 0) {
+    
+      // unless an infix is next, that takes it first.
+      if (pc+1 < _logo->codesize() && _logo->codefield(pc+1, FIELD_OPTYPE) == OPTYPE_BUILTIN &&
+          _logo->builtinarity(_logo->codefield(pc+1, FIELD_OP)) == INFIX_ARITY) {
+        break;
+      }
+      if (--pending.back()._need > 0) {
+        break;
+      }
+      LogoPending p = pending.back();
+      pending.pop_back();
+      if (p._word != NO_JUMP) {
+        // the arity is replaced by the return address.
+        short depth = stackdepth(p._word, depths, path, cycle);
+        if (depth < 0) {
+          bounded = false;
+          break;
+        }
+        peak = max(peak, (short)(p._base + depth));
+      }
+      // and it might leave something.
+      tos = p._base;
+      if (pending.empty()) {
+        break;
+      }
+      tos++;
+      peak = max(peak, tos);
+    }
+    
+  }
+  
+  path->pop_back();
+  short depth = bounded ? peak : -1;
+  (*depths)[start] = depth;
+  return depth;
+  
+}
+
+tJump LogoCompilerBase::wordend(short word) const {
+
+  // the code for the next word starts where this ends.
+  tJump end = _logo->_nextjcode;
+  for (short i=0; i<_wordcount; i++) {
+    if (_words[i]._jump != NO_JUMP && _words[i]._jump > _words[word]._jump && _words[i]._jump < end) {
+      end = _words[i]._jump;
+    }
+  }
+  return end;
+  
+}
+
+void LogoCompilerBase::deadwords(const set<string> &roots, set<string> *dead) const {
+
+  char name[LINE_LEN];
+  vector<string> names;
+  for (short i=0; i<_wordcount; i++) {
+    LogoStringResult result;
+    _logo->getstring(&result, _words[i]._name, _words[i]._namelen);
+    result.ncpy(name, sizeof(name));
+    names.push_back(to_upper_copy(string(name)));
+  }
+  
+  // the code still to look through, starting with the top.
+  vector<pair<tJump, tJump> > code;
+  code.push_back(make_pair((tJump)0, _logo->_nextcode));
+  vector<bool> reached(_wordcount, false);
+  set<string> want(roots);
+  
+  while (!want.empty() || !code.empty()) {
+  
+    // a word that's wanted for the first time has its code looked through.
+    for (short i=0; i<_wordcount; i++) {
+      if (!reached[i] && want.find(names[i]) != want.end()) {
+        reached[i] = true;
+        if (_words[i]._jump != NO_JUMP) {
+          code.push_back(make_pair(_words[i]._jump, wordend(i)));
+        }
+      }
+    }
+    want.clear();
+    if (code.empty()) {
+      break;
+    }
+    
+    pair<tJump, tJump> range = code.back();
+    code.pop_back();
+    for (short pc=range.first; pc<range.second; pc++) {
+      short type = _logo->codefield(pc, FIELD_OPTYPE);
+      short op = _logo->codefield(pc, FIELD_OP);
+      if (type == OPTYPE_JUMP || type == OPTYPE_TAILJUMP) {
+        for (short i=0; i<_wordcount; i++) {
+          if (_words[i]._jump == op) {
+            want.insert(names[i]);
+          }
+        }
+      }
+      else if (type == OPTYPE_STRING) {
+        // a word named in a list or given to something that calls it later.
+        LogoStringResult result;
+        _logo->getstring(&result, op, _logo->codefield(pc, FIELD_OPAND));
+        result.ncpy(name, sizeof(name));
+        want.insert(to_upper_copy(string(name)));
+      }
+    }
+  }
+  
+  for (short i=0; i<_wordcount; i++) {
+    if (!reached[i]) {
+      dead->insert(names[i]);
+    }
+  }
+  
+}
+
+void LogoCompilerBase::stackreport(ostream &str, const char *prefix) const {
+
+  char name[LINE_LEN];
+  if (_logo->_nextcode > 0) {
+    str << prefix << "(top) " << stackdepth(0) << endl;
+  }
+  for (short i=0; i<_wordcount; i++) {
+    if (_words[i]._jump == NO_JUMP) {
+      continue;
+    }
+    wordname(_words[i]._jump, name, sizeof(name));
+    str << prefix << name << " ";
+    vector<tJump> cycle;
+    short depth = stackdepth(_words[i]._jump, &cycle);
+    if (depth >= 0) {
+      str << depth << endl;
+      continue;
+    }
+    // show how it gets back to itself.
+    str << "recursive:";
+    for (size_t j=0; j<cycle.size(); j++) {
+      str << (j ? " ->" : "") << " ";
+      if (wordname(cycle[j], name, sizeof(name))) {
+        str << name;
+      }
+      else {
+        str << "(top)";
+      }
+    }
+    str << endl;
+  }
+  
+}
+
+void LogoCompilerBase::printword(const LogoWord &word) const {
 
   char name[LINE_LEN];
   LogoStringResult result;
@@ -833,7 +1755,7 @@ void LogoCompiler::printword(const LogoWord &word) const {
   }
 }
 
-void LogoCompiler::searchword(short op) const {
+void LogoCompilerBase::searchword(short op) const {
 
   for (short i=0; i<_wordcount; i++) {
     if (_words[i]._jump == op) {
@@ -844,9 +1766,39 @@ void LogoCompiler::searchword(short op) const {
   
 }
 
-void LogoCompiler::dump(short indent, short type, short op, short opand) const {
+bool LogoCompilerBase::wordname(short jump, char *name, int len) const {
+
+  for (short i=0; i<_wordcount; i++) {
+    if (_words[i]._jump == jump) {
+      LogoStringResult result;
+      _logo->getstring(&result, _words[i]._name, _words[i]._namelen);
+      result.ncpy(name, len-1);
+      return true;
+    }
+  }
+  return false;
+  
+}
+
+bool LogoCompilerBase::wordat(short pc, char *name, int len) const {
+
+  // the word that starts closest before the pc.
+  short word = -1;
+  for (short i=0; i<_wordcount; i++) {
+    if (_words[i]._jump <= pc && (word < 0 || _words[i]._jump > _words[word]._jump)) {
+      word = i;
+    }
+  }
+  if (word < 0) {
+    return false;
+  }
+  return wordname(_words[word]._jump, name, len);
+  
+}
+
+void LogoCompilerBase::dump(short indent, short type, short op, short opand) const {
 
-  if (type == OPTYPE_JUMP) {
+  if (type == OPTYPE_JUMP || type == OPTYPE_TAILJUMP) {
     entab(indent);
     searchword(op);
   }
@@ -856,7 +1808,7 @@ void LogoCompiler::dump(short indent, short type, short op, short opand) const {
 
 }
 
-void LogoCompiler::markword(tJump jump) const {
+void LogoCompilerBase::markword(tJump jump) const {
 
   LogoStringResult result;
   for (short i=0; i<_wordcount; i++) {
@@ -873,7 +1825,7 @@ void LogoCompiler::markword(tJump jump) const {
   
 }
 
-void LogoCompiler::printvar(const LogoVar &var) const {
+void LogoCompilerBase::printvar(const LogoVar &var) const {
 
   char name[LINE_LEN];
   LogoStringResult result;
@@ -884,12 +1836,12 @@ void LogoCompiler::printvar(const LogoVar &var) const {
   
 }
 
-void LogoCompiler::dump(const char *msg, bool all) const {
+void LogoCompilerBase::dump(const char *msg, bool all) const {
   cout << msg << endl;
   dump(all);
 }
 
-void LogoCompiler::dump(bool all) const {
+void LogoCompilerBase::dump(bool all) const {
 
   cout << "------" << endl;
   _logo->dumpcode(this, all);
@@ -897,7 +1849,7 @@ void LogoCompiler::dump(bool all) const {
   _logo->dumpvars(this);
 }
 
-short LogoCompiler::stepdump(short n, bool all) {
+short LogoCompilerBase::stepdump(short n, bool all) {
   dump(false);
   for (short i=0; i<n; i++) {
     cout << "step " << i << " -----------" << endl;
@@ -22,15 +22,49 @@
 #ifndef ARDUINO
 #include <fstream>
 #include <map>
+#include <set>
+#include <vector>
 #endif
 
+#define LINE_LEN            128       // these number of bytes
+
 #ifdef USE_LARGE_CODE
-#define MAX_WORDS           1024       // 6 bytes each
+#define TOKEN_LEN           LINE_LEN  // the longest single token when feeding
 #else
-#define MAX_WORDS           16        // 6 bytes each
+#define TOKEN_LEN           STRING_LEN
 #endif
 
-#define LINE_LEN            128       // these number of bytes
+// where we are when feeding in text.
+#define FEED_LINE           0         // the start of a line
+#define FEED_WORD           1         // in a token
+#define FEED_QUOTE          2         // in a quoted token
+#define FEED_ESCAPE         3         // just after a \ in a quoted token
+#define FEED_DONE           4         // a token is finished but we don't know if it's the last on the line
+#define FEED_COMMENT        5         // in a comment
+
+// a compiled image, all shorts little endian:
+//   header: IMAGE_MAGIC IMAGE_VERSION strings vars top wordcode words
+//   the bytes of the string pool
+//   name namelen for each variable
+//   optype op opand for each instruction of the top code and then the word code
+//   name namelen jump arity for each word
+//   the fletcher 16 checksum of everything before it
+// jumps in the word code are from the start of the word code so it doesn't
+// matter what START_JCODE is where it was compiled.
+#define IMAGE_MAGIC         0x474c    // LG
+#define IMAGE_VERSION       1
+#define IMAGE_HEADER_LEN    7         // shorts
+
+// where we are when feeding in an image.
+#define IMAGE_HEADER        0
+#define IMAGE_STRINGS       1
+#define IMAGE_VARS          2
+#define IMAGE_TOP           3
+#define IMAGE_WORDCODE      4
+#define IMAGE_WORDS         5
+#define IMAGE_SUM           6
+#define IMAGE_DONE          7         // waiting for the next one
+#define IMAGE_ERR           8         // ignore everything until a flush
 
 typedef struct {
   tStrPool  _name;
@@ -39,10 +73,23 @@ typedef struct {
  tByte      _arity; // smaller than 256?
 } LogoWord;
 
-class LogoCompiler {
+#ifndef ARDUINO
+// what a program needs to run from flash (see flashcode --config).
+typedef struct {
+  short     _code; // all the instructions in the flash code
+  short     _jcode; // where the words start in it
+  short     _strings; // in the pool after it's compiled
+  short     _vars;
+  short     _words;
+  short     _lists; // the nodes its lists need
+  short     _stack; // the worst case, -1 when a word can call itself forever
+} LogoSizes;
+#endif
+
+class LogoCompilerBase {
 
 public:
-  LogoCompiler(Logo * logo);
+  LogoCompilerBase(LogoBase *logo, LogoWord *words, short maxwords);
   
   // the compiler.
   void compile(const char *code) {
@@ -51,9 +98,26 @@ public:
   }
   void compile(LogoString *str);
   int callword(const char *word);
+  
+  // compile a command after the last one and run it after or alongside whatever is
+  // running, only the code it needs is cleared. Returns any error.
+  int command(const char *cmd);
+  
+  // compile text as it comes in, in whatever sized pieces. Each token is compiled as soon
+  // as it's complete and flush() finishes off the last one.
+  void feed(const char *code, short len);
+  void feed(char c);
+  void flush();
+  
+  // load a compiled image (see writeimage) as it comes in. It replaces all the code, words,
+  // strings and variables once the header arrives and it's checked when the checksum arrives.
+  void feedimage(const char *data, short len);
 
   // main execution
   void reset();
+  
+  // build lists of literals when compiling (not for flash code).
+  void setconstlists(bool constlists) { _constlists = constlists; }
 
 #ifdef LOGO_DEBUG
  void outstate() const;
@@ -65,6 +129,8 @@ public:
   short stepdump(short n, bool all=true);
   void dump(short indent, short type, short op, short opand) const;
   void searchword(short op) const;
+  bool wordname(short jump, char *name, int len) const;
+  bool wordat(short pc, char *name, int len) const;
   void markword(tJump jump) const;
   void printword(const LogoWord &word) const;
   void printvar(const LogoVar &var) const;
@@ -74,13 +140,34 @@ public:
   bool haswords() { return _wordcount > 0; }
   void entab(short indent) const;
   void printwordstring(const LogoWord &word, std::ostream &str) const;
-  static int generatecode(std::fstream &file, const std::map<std::string, std::string> &directives, std::ostream &str);
+  static int generatecode(std::fstream &file, const std::map<std::string, std::string> &directives, std::ostream &str, LogoSizes *sizes=0);
   static int inlinelgo(std::fstream &file, const std::map<std::string, std::string> &directives, std::ostream &str);
   static int inlinefile(std::fstream &file, std::ostream &str);
-  static int updateino(const std::string &infn, std::fstream &infile, std::fstream &outfile);
-  static int includelgo(const std::string &infn, const std::map<std::string, std::string> &directives, std::fstream &outfile);
+  static int updateino(const std::string &infn, std::fstream &infile, std::fstream &outfile, LogoSizes *sizes=0);
+  static int includelgo(const std::string &infn, const std::map<std::string, std::string> &directives, std::fstream &outfile, LogoSizes *sizes=0);
+  
+  // how big everything needs to be to run what's compiled from flash.
+  void measure(LogoSizes *sizes) const;
+  static void growsizes(LogoSizes *sizes, const LogoSizes &more);
+  static void writeconfig(const LogoSizes &sizes, const std::string &name, std::ostream &str);
+  
+  // the most stack the code at pc can use including the arguments and return address
+  // of a word, -1 if it can call itself without a tail call and then cycle is the
+  // words it goes through to get back to itself.
+  short stackdepth(tJump pc, std::vector<tJump> *cycle=0) const;
+  
+  // a line with the most stack for the code at the top and each word.
+  void stackreport(std::ostream &str, const char *prefix) const;
+  
+  // the words (in upper case) that can't be reached from the code at the top or any of
+  // the roots by calling them or naming them in a string.
+  void deadwords(const std::set<std::string> &roots, std::set<std::string> *dead) const;
+  
+  // words with these names (in upper case) are skipped when they are defined.
+  void leaveout(const std::set<std::string> *words) { _leaveout = words; }
   int compile(std::fstream &file, const std::map<std::string, std::string> &directives, bool autoassign=false);
   int compilefn(const std::string &name, const std::map<std::string, std::string> &directives, bool autoassign=false);
+  void writeimage(std::string *image) const;
   static void getdirectives(const std::string line, std::map<std::string, std::string> *directives);
   static void replacedirectives(std::string *line, const std::map<std::string, std::string> &directives, bool autoassign, int *count);
 #endif
@@ -91,7 +178,7 @@ public:
 
 private:
   
-  Logo *_logo;
+  LogoBase *_logo;
   
   // the state variables for defining new words
   bool _inword;
@@ -101,18 +188,67 @@ private:
   short _jump;
   short _wordarity;
   
+  // the state for building constant lists
+  tJump _liststart;
+  short _listdepth;
+  bool _constlists;
+  
+  // the state for feeding in text
+  char _token[TOKEN_LEN];
+  short _tokenlen;
+  tByte _feedstate;
+  
+  // the state for feeding in an image
+  tByte _imgsection;
+  short _imgcount; // items left in the section
+  short _imghead[IMAGE_HEADER_LEN];
+  short _imgitem[4]; // the shorts of the item
+  tByte _imgbytes; // bytes we have of the item
+  unsigned short _imgsum1;
+  unsigned short _imgsum2;
+  
   // words
   short _wordcount;
-  LogoWord _words[MAX_WORDS];
+  LogoWord *_words;
+  short _maxwords;
   
   // parser
   bool dodefine(LogoString *str, short wordstart, short wordlen, bool eol);
   void compilewords(LogoString *str, short start, short len, bool define);
+  bool compiletoken(LogoString *str, short wordstart, short wordlen, bool eol);
+  void feedtoken(bool eol);
+  void imagebyte(tByte b);
+  void imageitem();
+  void imagesection(tByte section);
+  void imageerror(short err);
+  void imagestrings();
   void compileword(tJump *next, LogoString *str, short wordstart, short wordlen, short op);
   void finishword(short word, short wordlen, short jump, short arity);
   short findword(LogoString *str, short wordstart, short wordlen) const;
   short findword(LogoStringResult *str) const;
+#ifndef ARDUINO
+  short stackdepth(tJump pc, std::map<tJump, short> *depths, std::vector<tJump> *path, std::vector<tJump> *cycle) const;
+  tJump wordend(short word) const;
+  
+  // the words being left out.
+  const std::set<std::string> *_leaveout;
+  bool _leavingout; // in one of them until its END
+#endif
   
 };
 
+// a compiler that holds as many words as the capacity says (see LogoT).
+template <class C>
+class LogoCompilerT: public LogoCompilerBase {
+
+public:
+  LogoCompilerT(LogoBase *logo): LogoCompilerBase(logo, _store, C::words) {}
+  
+private:
+  LogoWord _store[C::words];
+  
+};
+
+typedef LogoCompilerT<LogoCapacity> LogoCompiler;
+
 #endif // H_logocompiler
@@ -0,0 +1,83 @@
+/*
+  logoevents.hpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 19-Oct-2026
+
+  Tiniest Logo Intepreter events. Something like the socket callback puts events
+  in one end and the Logo takes them out of the other and runs the word that
+  handles them (see WHEN).
+
+  There is only ever one thing putting them in and one taking them out so the
+  queue doesn't need a lock, just the two indexes that each side owns.
+
+  This work is licensed under the Creative Commons Attribution 4.0 International License.
+  To view a copy of this license, visit http://creativecommons.org/licenses/by/4.0/ or
+  send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+  https://github.com/visualopsholdings/tinylogo
+*/
+
+#ifndef H_logoevents
+#define H_logoevents
+
+#include <string.h>
+
+#define EVENT_QUEUE_LEN     8         // a power of 2, 146 bytes each
+#define EVENT_NAME_LEN      16
+#define EVENT_DATA_LEN      128
+
+typedef struct {
+  char               _name[EVENT_NAME_LEN];
+  char               _data[EVENT_DATA_LEN]; // the whole payload
+  short              _datalen;
+} LogoEvent;
+
+class LogoEventQueue {
+
+public:
+  LogoEventQueue(): _head(0), _tail(0) {}
+
+  // the one putting them in.
+  bool full() const {
+    return (unsigned short)(_tail - __atomic_load_n(&_head, __ATOMIC_ACQUIRE)) >= EVENT_QUEUE_LEN;
+  }
+  bool push(const char *name, short namelen, const char *data, short datalen) {
+    if (full()) {
+      return false;
+    }
+    LogoEvent *event = &_events[_tail & (EVENT_QUEUE_LEN - 1)];
+    if (namelen >= EVENT_NAME_LEN) {
+      namelen = EVENT_NAME_LEN - 1;
+    }
+    memcpy(event->_name, name, namelen);
+    event->_name[namelen] = 0;
+    if (datalen > EVENT_DATA_LEN) {
+      datalen = EVENT_DATA_LEN;
+    }
+    memcpy(event->_data, data, datalen);
+    event->_datalen = datalen;
+    // only now can the other side see it.
+    __atomic_store_n(&_tail, (unsigned short)(_tail + 1), __ATOMIC_RELEASE);
+    return true;
+  }
+
+  // the one taking them out.
+  bool empty() const {
+    return __atomic_load_n(&_tail, __ATOMIC_ACQUIRE) == _head;
+  }
+  LogoEvent *front() {
+    return empty() ? 0 : &_events[_head & (EVENT_QUEUE_LEN - 1)];
+  }
+  void pop() {
+    __atomic_store_n(&_head, (unsigned short)(_head + 1), __ATOMIC_RELEASE);
+  }
+
+private:
+  LogoEvent _events[EVENT_QUEUE_LEN];
+  unsigned short _head; // only the one taking them out changes this
+  unsigned short _tail; // and only the one putting them in changes this
+
+};
+
+#endif // H_logoevents
@@ -0,0 +1,39 @@
+/*
+  logoindex.hpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 19-Oct-2026
+
+  Tiniest Logo Intepreter index types. The smallest type that can index something
+  of a size with a value left over for "none", worked out by the compiler so a
+  small program only pays a byte for each jump or list node.
+
+    typedef LogoIndex<MAX_CODE>::type tJump;
+
+  This work is licensed under the Creative Commons Attribution 4.0 International License.
+  To view a copy of this license, visit http://creativecommons.org/licenses/by/4.0/ or
+  send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+  https://github.com/visualopsholdings/tinylogo
+*/
+
+#ifndef H_logoindex
+#define H_logoindex
+
+template <bool small>
+struct LogoIndexType {
+  typedef short type;
+  enum { none = -1 };
+};
+
+template <>
+struct LogoIndexType<true> {
+  typedef unsigned char type;
+  enum { none = 255 };
+};
+
+template <long size>
+struct LogoIndex: public LogoIndexType<(size < 256)> {
+};
+
+#endif // H_logoindex
@@ -0,0 +1,130 @@
+/*
+  logoio.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 19-Oct-2026
+
+  This work is licensed under the Creative Commons Attribution 4.0 International License.
+  To view a copy of this license, visit http://creativecommons.org/licenses/by/4.0/ or
+  send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+  https://github.com/visualopsholdings/tinylogo
+*/
+
+#include "logoio.hpp"
+
+#ifndef ARDUINO
+
+#include "logo.hpp"
+
+using namespace std;
+
+void LogoRecordingIO::record(short event, short pin, short value) {
+
+  LogoIOEvent e;
+  e._ms = _time ? _time->currentms() : 0;
+  e._event = event;
+  e._pin = pin;
+  e._value = value;
+  _events.push_back(e);
+
+}
+
+void LogoRecordingIO::pinmode(short pin, short mode) {
+
+  flush();
+  record(IO_EV_MODE, pin, mode);
+
+}
+
+short LogoRecordingIO::dread(short pin) {
+
+  // it has to see what we wrote.
+  flush();
+  short value = pin >= 0 && pin < (short)_inputs.size() ? _inputs[pin] : 0;
+  record(IO_EV_READ, pin, value);
+  return value;
+
+}
+
+void LogoRecordingIO::dwrite(short pin, bool high) {
+
+  // just like the real one, a second write to the same pin can't be merged.
+  for (size_t i=0; i<_pending.size(); i+=2) {
+    if (_pending[i] == pin) {
+      flush();
+      break;
+    }
+  }
+  _pending.push_back(pin);
+  _pending.push_back(high ? 1 : 0);
+
+}
+
+void LogoRecordingIO::awrite(short pin, short value) {
+
+  flush();
+  record(IO_EV_AWRITE, pin, value);
+
+}
+
+void LogoRecordingIO::rgbpin(short channel, short pin) {
+
+  flush();
+  record(IO_EV_RGBPIN, pin, channel);
+
+}
+
+void LogoRecordingIO::rgbwrite(short channel, short pin, short value) {
+
+  flush();
+  record(IO_EV_RGBWRITE, pin, value);
+
+}
+
+void LogoRecordingIO::flush() {
+
+  if (_pending.empty()) {
+    return;
+  }
+  record(IO_EV_FLUSH, 0, _pending.size() / 2);
+  for (size_t i=0; i<_pending.size(); i+=2) {
+    short pin = _pending[i];
+    if (pin >= (short)_levels.size()) {
+      _levels.resize(pin + 1);
+    }
+    _levels[pin] = _pending[i+1];
+    record(IO_EV_WRITE, pin, _pending[i+1]);
+  }
+  _pending.clear();
+
+}
+
+void LogoRecordingIO::setinput(short pin, short value) {
+
+  if (pin >= (short)_inputs.size()) {
+    _inputs.resize(pin + 1);
+  }
+  _inputs[pin] = value;
+
+}
+
+short LogoRecordingIO::level(short pin) const {
+
+  return pin >= 0 && pin < (short)_levels.size() ? _levels[pin] : 0;
+
+}
+
+vector<LogoIOEvent> LogoRecordingIO::writes(short pin) const {
+
+  vector<LogoIOEvent> w;
+  for (auto i: _events) {
+    if (i._event == IO_EV_WRITE && i._pin == pin) {
+      w.push_back(i);
+    }
+  }
+  return w;
+
+}
+
+#endif // ARDUINO
@@ -0,0 +1,111 @@
+/*
+  logoio.hpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 19-Oct-2026
+
+  Tiniest Logo Intepreter pins. The pin words go through one of these when the Logo
+  has one (see ArduinoIO for the fast one on a board) so they can be recorded and
+  timed on the host.
+
+  Digital writes can be held back and written together when flush() is called
+  (at a WAIT, a read and the end of each loop) but never two to the same pin so
+  every change to a pin still happens.
+
+  This work is licensed under the Creative Commons Attribution 4.0 International License.
+  To view a copy of this license, visit http://creativecommons.org/licenses/by/4.0/ or
+  send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+  https://github.com/visualopsholdings/tinylogo
+*/
+
+#ifndef H_logoio
+#define H_logoio
+
+#ifndef ARDUINO
+#include <vector>
+#endif
+
+// pin modes
+#define IO_INPUT            0
+#define IO_OUTPUT           1
+#define IO_INPUT_PULLUP     2
+
+class LogoIO {
+
+public:
+  virtual void pinmode(short pin, short mode) = 0;
+  virtual short dread(short pin) = 0;
+  virtual void dwrite(short pin, bool high) = 0;
+  virtual void awrite(short pin, short value) = 0;
+
+  // the rgb channels (see PINRGB and RGBOUT).
+  virtual void rgbpin(short channel, short pin) = 0;
+  virtual void rgbwrite(short channel, short pin, short value) = 0;
+
+  // write anything that has been held back.
+  virtual void flush() = 0;
+
+};
+
+#ifndef ARDUINO
+
+class LogoTimeProvider;
+
+// what happened to the pins.
+#define IO_EV_MODE          1
+#define IO_EV_READ          2
+#define IO_EV_WRITE         3
+#define IO_EV_AWRITE        4
+#define IO_EV_RGBPIN        5
+#define IO_EV_RGBWRITE      6
+#define IO_EV_FLUSH         7
+
+typedef struct {
+  unsigned long      _ms;
+  short              _event;
+  short              _pin;
+  short              _value;
+} LogoIOEvent;
+
+// records everything with the time it happened so tests can check the timing.
+class LogoRecordingIO: public LogoIO {
+
+public:
+  LogoRecordingIO(LogoTimeProvider *time=0): _time(time) {}
+
+  // LogoIO
+  virtual void pinmode(short pin, short mode);
+  virtual short dread(short pin);
+  virtual void dwrite(short pin, bool high);
+  virtual void awrite(short pin, short value);
+  virtual void rgbpin(short channel, short pin);
+  virtual void rgbwrite(short channel, short pin, short value);
+  virtual void flush();
+
+  // what dread gets for a pin.
+  void setinput(short pin, short value);
+
+  // the level of a pin after the last flush.
+  short level(short pin) const;
+
+  const std::vector<LogoIOEvent> &events() const { return _events; }
+  void clear() { _events.clear(); }
+
+  // just the writes to a pin.
+  std::vector<LogoIOEvent> writes(short pin) const;
+
+private:
+  LogoTimeProvider *_time;
+  std::vector<LogoIOEvent> _events;
+  std::vector<short> _inputs;
+  std::vector<short> _levels;
+  std::vector<short> _pending; // the writes held back, pin then value
+
+  void record(short event, short pin, short value);
+
+};
+
+#endif // ARDUINO
+
+#endif // H_logoio
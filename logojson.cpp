@@ -0,0 +1,238 @@
+/*
+  logojson.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 19-Oct-2026
+
+  This work is licensed under the Creative Commons Attribution 4.0 International License.
+  To view a copy of this license, visit http://creativecommons.org/licenses/by/4.0/ or
+  send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+  https://github.com/visualopsholdings/tinylogo
+*/
+
+#include "logojson.hpp"
+
+#include <string.h>
+
+LogoJsonField::LogoJsonField(const char *field, char *value, short len):
+  _field(field), _fieldlen(strlen(field)), _value(value), _valuesize(len), _valuelen(0),
+  _result(JSON_MORE), _depth(0), _object(false), _expectkey(false),
+  _instring(false), _escape(false), _hex(0), _code(0),
+  _key(false), _keypos(0), _keymiss(false),
+  _matched(false), _capture(false), _scalar(false) {
+
+  if (_valuesize > 0) {
+    _value[0] = 0;
+  }
+
+}
+
+short LogoJsonField::feed(const char *data, short len) {
+
+  for (short i=0; i<len && _result == JSON_MORE; i++) {
+    feed(data[i]);
+  }
+  return _result;
+
+}
+
+short LogoJsonField::found() {
+
+  _value[_valuelen] = 0;
+  _result = JSON_FOUND;
+  return _result;
+
+}
+
+void LogoJsonField::copy(char c) {
+
+  // leave room for the null.
+  if (_valuelen >= _valuesize - 1) {
+    _result = JSON_TOO_LONG;
+    return;
+  }
+  _value[_valuelen++] = c;
+
+}
+
+void LogoJsonField::strchar(char c) {
+
+  if (_key) {
+    if (_keypos < _fieldlen && _field[_keypos] == c) {
+      _keypos++;
+    }
+    else {
+      _keymiss = true;
+    }
+  }
+  else if (_capture) {
+    copy(c);
+  }
+
+}
+
+short LogoJsonField::feed(char c) {
+
+  if (_result != JSON_MORE) {
+    return _result;
+  }
+
+  if (_instring) {
+
+    if (_hex > 0) {
+      // \uXXXX, anything that isn't plain ASCII is just a ?
+      short d;
+      if (c >= '0' && c <= '9') {
+        d = c - '0';
+      }
+      else if (c >= 'a' && c <= 'f') {
+        d = c - 'a' + 10;
+      }
+      else if (c >= 'A' && c <= 'F') {
+        d = c - 'A' + 10;
+      }
+      else {
+        _result = JSON_BAD;
+        return _result;
+      }
+      _code = (_code << 4) | d;
+      _hex--;
+      if (_hex == 0) {
+        strchar(_code > 0 && _code < 0x80 ? (char)_code : '?');
+      }
+      return _result;
+    }
+
+    if (_escape) {
+      _escape = false;
+      switch (c) {
+        case 'n': strchar('\n'); break;
+        case 't': strchar('\t'); break;
+        case 'r': strchar('\r'); break;
+        case 'b': strchar('\b'); break;
+        case 'f': strchar('\f'); break;
+        case 'u': _hex = 4; _code = 0; break;
+        default: strchar(c); break;
+      }
+      return _result;
+    }
+
+    if (c == '\\') {
+      _escape = true;
+    }
+    else if (c == '"') {
+      _instring = false;
+      if (_key) {
+        _key = false;
+        _matched = !_keymiss && _keypos == _fieldlen;
+      }
+      else if (_capture) {
+        return found();
+      }
+    }
+    else {
+      strchar(c);
+    }
+    return _result;
+  }
+
+  // a number, true etc finishes on anything that can't be in it.
+  if (_scalar) {
+    if (c == ',' || c == '}' || c == ']' || c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+      return found();
+    }
+    copy(c);
+    return _result;
+  }
+
+  switch (c) {
+
+    case ' ':
+    case '\t':
+    case '\r':
+    case '\n':
+      break;
+
+    case '"':
+      _instring = true;
+      if (_depth == 1 && _expectkey) {
+        _key = true;
+        _keypos = 0;
+        _keymiss = false;
+        _expectkey = false;
+      }
+      else if (_depth == 1 && _matched) {
+        _capture = true;
+      }
+      break;
+
+    case ':':
+      if (_depth == 0) {
+        _result = JSON_BAD;
+      }
+      break;
+
+    case ',':
+      if (_depth == 0) {
+        _result = JSON_BAD;
+      }
+      else if (_depth == 1) {
+        _expectkey = _object;
+        _matched = false;
+      }
+      break;
+
+    case '{':
+    case '[':
+      if (_depth == 0) {
+        _object = c == '{';
+        _expectkey = _object;
+      }
+      else if (_depth == 1) {
+        // we don't do objects and arrays.
+        _matched = false;
+      }
+      _depth++;
+      break;
+
+    case '}':
+    case ']':
+      if (_depth == 0) {
+        _result = JSON_BAD;
+        break;
+      }
+      _depth--;
+      if (_depth == 0) {
+        _result = JSON_NOT_FOUND;
+      }
+      break;
+
+    default:
+      if (_depth == 0) {
+        _result = JSON_BAD;
+      }
+      else if (_depth == 1 && _matched) {
+        _capture = true;
+        _scalar = true;
+        copy(c);
+      }
+      break;
+  }
+
+  return _result;
+
+}
+
+short LogoJsonField::finish() {
+
+  if (_result != JSON_MORE) {
+    return _result;
+  }
+  if (_scalar) {
+    return found();
+  }
+  _result = _depth == 0 && !_instring ? JSON_NOT_FOUND : JSON_BAD;
+  return _result;
+
+}
@@ -0,0 +1,73 @@
+/*
+  logojson.hpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 19-Oct-2026
+
+  Pull one top level field out of some JSON as it comes in, without ever
+  having all of the JSON. It only needs itself and the buffer the value goes
+  into so it doesn't matter how big the JSON is.
+
+  Strings are unescaped, numbers, true, false and null come back as their text
+  and objects and arrays are not found.
+
+  This work is licensed under the Creative Commons Attribution 4.0 International License.
+  To view a copy of this license, visit http://creativecommons.org/licenses/by/4.0/ or
+  send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+  https://github.com/visualopsholdings/tinylogo
+*/
+
+#ifndef H_logojson
+#define H_logojson
+
+// what feed and finish return.
+#define JSON_MORE           0 // keep going
+#define JSON_FOUND          1 // the value is ready
+#define JSON_NOT_FOUND      2 // the JSON has finished without it
+#define JSON_TOO_LONG       3 // the value won't fit
+#define JSON_BAD            4 // it isn't JSON
+
+class LogoJsonField {
+
+public:
+  // the value is null terminated in value.
+  LogoJsonField(const char *field, char *value, short len);
+
+  // feed in some more of the JSON, stop feeding when it's not JSON_MORE.
+  short feed(const char *data, short len);
+  short feed(char c);
+
+  // there is no more JSON.
+  short finish();
+
+  short valuelen() const { return _valuelen; }
+
+private:
+  const char *_field;
+  short _fieldlen;
+  char *_value;
+  short _valuesize;
+  short _valuelen;
+  short _result;
+  short _depth;
+  bool _object;       // the top is an object
+  bool _expectkey;    // the next string at the top is a key
+  bool _instring;
+  bool _escape;
+  short _hex;         // hex digits left in a \u
+  short _code;
+  bool _key;          // in a key at the top
+  short _keypos;      // how much of the field it has matched
+  bool _keymiss;
+  bool _matched;      // the next value at the top is ours
+  bool _capture;      // copying a value
+  bool _scalar;       // and it's not a string
+
+  void strchar(char c);
+  void copy(char c);
+  short found();
+
+};
+
+#endif // H_logojson
@@ -0,0 +1,113 @@
+/*
+  logoserial.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 19-Oct-2026
+
+  This work is licensed under the Creative Commons Attribution 4.0 International License.
+  To view a copy of this license, visit http://creativecommons.org/licenses/by/4.0/ or
+  send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+  https://github.com/visualopsholdings/tinylogo
+*/
+
+#include "logoserial.hpp"
+
+#include <string.h>
+
+LogoSerialBuffer::LogoSerialBuffer():
+  _start(0), _scan(0), _end(0), _cmdend(-1), _skip(false), _overruns(0) {
+}
+
+short LogoSerialBuffer::space(char **p) {
+
+  // move what we have of the next one back to the start, but never while
+  // somebody is looking at the one before it.
+  if (_end == SERIAL_BUFFER_LEN && _start > 0 && _cmdend < 0) {
+    short len = _end - _start;
+    memmove(_buf, _buf + _start, len);
+    _scan -= _start;
+    _start = 0;
+    _end = len;
+  }
+  *p = _buf + _end;
+  return SERIAL_BUFFER_LEN - _end;
+
+}
+
+void LogoSerialBuffer::wrote(short len) {
+
+  _end += len;
+
+}
+
+void LogoSerialBuffer::write(const char *s) {
+
+  short len = strlen(s);
+  while (len > 0) {
+    char *p;
+    short n = space(&p);
+    if (n == 0) {
+      return;
+    }
+    if (n > len) {
+      n = len;
+    }
+    memcpy(p, s, n);
+    wrote(n);
+    s += n;
+    len -= n;
+  }
+
+}
+
+bool LogoSerialBuffer::ready(LogoSimpleString *cmd) {
+
+  if (_cmdend >= 0) {
+    cmd->set(_buf + _start, _cmdend - _start);
+    return true;
+  }
+
+  while (_scan < _end) {
+    char c = _buf[_scan];
+    if (c != '\n' && c != '\r' && c != ';') {
+      _scan++;
+      continue;
+    }
+    _buf[_scan] = 0;
+    if (_skip || _scan == _start) {
+      // the end of one we threw away or an empty one.
+      _skip = false;
+      _start = ++_scan;
+      continue;
+    }
+    _cmdend = _scan;
+    cmd->set(_buf + _start, _cmdend - _start);
+    return true;
+  }
+
+  if (_start == _end) {
+    // all used up so start again at the top.
+    _start = _scan = _end = 0;
+  }
+  else if (_start == 0 && _end == SERIAL_BUFFER_LEN) {
+    // it will never fit.
+    if (!_skip) {
+      _overruns++;
+      _skip = true;
+    }
+    _start = _scan = _end = 0;
+  }
+  return false;
+
+}
+
+void LogoSerialBuffer::next() {
+
+  if (_cmdend < 0) {
+    return;
+  }
+  _start = _scan = _cmdend + 1;
+  _cmdend = -1;
+
+}
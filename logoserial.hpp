@@ -0,0 +1,64 @@
+/*
+  logoserial.hpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 19-Oct-2026
+
+  Tiniest Logo Intepreter serial commands. The serial port reads straight into
+  the free end of the buffer in as big a piece as it can and each command that
+  comes out is just a pointer into the buffer, so nothing is copied a character
+  at a time.
+
+  A command ends with a newline or a ; and it's null terminated in place. The
+  part of the next command that has come in is moved back to the start only when
+  there is no room left at the end.
+
+  This work is licensed under the Creative Commons Attribution 4.0 International License.
+  To view a copy of this license, visit http://creativecommons.org/licenses/by/4.0/ or
+  send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+  https://github.com/visualopsholdings/tinylogo
+*/
+
+#ifndef H_logoserial
+#define H_logoserial
+
+#include "logostring.hpp"
+
+#if defined(ARDUINO) && defined(__AVR__)
+#define SERIAL_BUFFER_LEN   96        // the longest command
+#else
+#define SERIAL_BUFFER_LEN   512       // the longest command
+#endif
+
+class LogoSerialBuffer {
+
+public:
+  LogoSerialBuffer();
+
+  // where the next bytes can be read straight into and how many will fit.
+  short space(char **p);
+  void wrote(short len);
+
+  // copy some in as if they were read.
+  void write(const char *s);
+
+  // the next whole command, it's good until next().
+  bool ready(LogoSimpleString *cmd);
+  void next();
+
+  // commands that were too long and thrown away.
+  unsigned long overruns() const { return _overruns; }
+
+private:
+  char _buf[SERIAL_BUFFER_LEN + 1];
+  short _start; // the command that's coming in
+  short _scan; // how far we have looked for the end of it
+  short _end; // where the next bytes go
+  short _cmdend; // the end of the one that's ready, -1 for none
+  bool _skip; // throwing away the rest of one that was too long
+  unsigned long _overruns;
+
+};
+
+#endif // H_logoserial
@@ -15,15 +15,6 @@
 
 #include <Arduino.h>
 
-#ifdef ESP32
-#ifdef USE_WIFI
-#include <SocketIOclient.h>
-extern SocketIOclient gWSClient;
-#endif
-#endif
-
-RingBuffer gBuffer; // 64 bytes
-
 void LogoSketchBase::setup(int baud)  {
 
   _failed = true;
@@ -64,32 +55,42 @@ void LogoSketchBase::loop() {
     return;
   }
   
-  // consume the serial data into the buffer as it comes in.
-  while (Serial.available()) {
-    gBuffer.write(Serial.read());
+  // every command that has come in, straight out of the buffer. When a whole
+  // program is pasted in there can be more waiting once there's room for it.
+  bool more = true;
+  while (more) {
+    more = readserial();
+    LogoSimpleString cmd;
+    while (_buffer.ready(&cmd)) {
+      int err = docommand(cmd.c_str());
+      _buffer.next();
+      if (err) {
+        showErr(2, err);
+      }
+    }
   }
 
-  // accept the buffer into the command parser
-  _cmd.accept(&gBuffer);
-
-  // when there is a valid command
-  if (_cmd.ready()) {
-  
-    // read it in
-    _cmd.read(_cmdbuf, sizeof(_cmdbuf));
-    
-    // reset the code but keep all our words we have defined.
-    logo()->resetcode();
-    
-    // process a command.
-    int err = docommand(_cmdbuf);
-    if (err) {
-      showErr(2, err);
+  // run for our quantum, but as soon as there is a WAIT let everything else
+  // have a go.
+  unsigned long start = micros();
+  unsigned long us = 0;
+  short steps = 0;
+  bool waited = false;
+  int err = 0;
+  do {
+    err = logo()->step();
+    steps++;
+    us = micros() - start;
+    if (logo()->waiting()) {
+      waited = true;
+      break;
     }
-
   }
-
-  int err = logo()->step();
+  while (!err && steps < _quantumsteps && (_quantumus == 0 || us < _quantumus));
+  
+  // the pins written this loop all go out together.
+  logo()->flushio();
+  updatequantumstats(steps, us, waited);
   if (err && err != LG_STOP) {
     showErr(3, err);
   }
@@ -97,8 +98,7 @@ void LogoSketchBase::loop() {
 #ifdef ESP32
 
 #ifdef USE_WIFI
-  // let the websockets client check for incoming messages
-  gWSClient.loop();
+  logo()->_wifi.loop(logo());
 #endif
   
 #ifdef USE_BT
@@ -109,6 +109,99 @@ void LogoSketchBase::loop() {
 
 }
 
+bool LogoSketchBase::readserial() {
+
+  // as much as will fit in one go, returns true if there is more.
+  short avail = Serial.available();
+  while (avail > 0) {
+    char *p;
+    short len = _buffer.space(&p);
+    if (len == 0) {
+      return true;
+    }
+    if (len > avail) {
+      len = avail;
+    }
+    len = Serial.readBytes(p, len);
+    if (len <= 0) {
+      break;
+    }
+    _buffer.wrote(len);
+    avail -= len;
+  }
+  return false;
+  
+}
+
+void LogoSketchBase::setquantum(short steps, unsigned long us) {
+
+  _quantumsteps = steps > 0 ? steps : 1;
+  _quantumus = us;
+  
+  // the loop itself is the delay between steps now.
+  logo()->setidledelay(_quantumsteps == 1 && _quantumus == 0);
+  
+  resetquantumstats();
+  
+}
+
+void LogoSketchBase::resetquantumstats() {
+
+  _stats._loops = 0;
+  _stats._steps = 0;
+  _stats._waits = 0;
+  _stats._maxus = 0;
+  for (short i=0; i<QUANTUM_BUCKETS; i++) {
+    _stats._used[i] = 0;
+  }
+  
+}
+
+void LogoSketchBase::updatequantumstats(short steps, unsigned long us, bool waited) {
+
+  _stats._loops++;
+  _stats._steps += steps;
+  if (waited) {
+    _stats._waits++;
+  }
+  if (us > _stats._maxus) {
+    _stats._maxus = us;
+  }
+  
+  // whichever of the steps or the time was used up the most.
+  unsigned long used = (unsigned long)steps * QUANTUM_BUCKETS / _quantumsteps;
+  if (_quantumus > 0) {
+    unsigned long tused = us * QUANTUM_BUCKETS / _quantumus;
+    if (tused > used) {
+      used = tused;
+    }
+  }
+  if (used >= QUANTUM_BUCKETS) {
+    used = QUANTUM_BUCKETS - 1;
+  }
+  _stats._used[used]++;
+  
+}
+
+void LogoSketchBase::printquantumstats() const {
+
+  Serial.print("loops ");
+  Serial.print(_stats._loops);
+  Serial.print(" steps ");
+  Serial.print(_stats._steps);
+  Serial.print(" waits ");
+  Serial.print(_stats._waits);
+  Serial.print(" maxus ");
+  Serial.println(_stats._maxus);
+  Serial.print("used");
+  for (short i=0; i<QUANTUM_BUCKETS; i++) {
+    Serial.print(" ");
+    Serial.print(_stats._used[i]);
+  }
+  Serial.println();
+  
+}
+
 void LogoSketchBase::showErr(int mode, int n) {
 
   if (n == LG_EXCEPTION) {
@@ -125,7 +218,7 @@ void LogoSketchBase::showErr(int mode, int n) {
 }
 
 LogoSketch::LogoSketch(char strings[] PROGMEM, const PROGMEM short *code): 
-  _strings(strings), _code(code), _logo(&_time, &_strings, &_code) {
+  _strings(strings), _code(code), _logo(&_time, &_strings, &_code, &_io) {
 
 }
 
@@ -135,18 +228,20 @@ void LogoSketch::precompile() {
 int LogoSketch::dosetup(const char *cmd) {
 
   // we don't know how to compile for now when doing a 
-  return docommand(cmd);
+  return _logo.callword(cmd);
   
 }
 
 int LogoSketch::docommand(const char *cmd) {
 
+  // the code is in flash so the word just replaces whatever is running.
+  _logo.resetcode();
   return _logo.callword(cmd);
   
 }
 
 LogoInlineSketch::LogoInlineSketch(char program[] PROGMEM):
-  _program(program), _logo(&_time), _compiler(&_logo) {
+  _program(program), _logo(&_time, 0, 0, &_io), _compiler(&_logo) {
   
 }
 
@@ -172,8 +267,35 @@ int LogoInlineSketch::docompile(const char *cmd) {
   
 }
 
+int LogoInlineSketch::dofeed(const char *code, short len) {
+
+  _compiler.feed(code, len);
+  return _logo.geterr();
+  
+}
+
+void LogoInlineSketch::doflush() {
+
+  _compiler.flush();
+  
+}
+
+int LogoInlineSketch::doimage(const char *data, short len) {
+
+  _compiler.feedimage(data, len);
+  return _logo.geterr();
+  
+}
+
 int LogoInlineSketch::docommand(const char *cmd) {
 
-  return docompile(cmd);
+  // stop everything the commands started, like the bluetooth one.
+  if (strcmp(cmd, "RESETCODE") == 0) {
+    _logo.resetcode();
+    return 0;
+  }
+  
+  // after or alongside whatever is running, keeping our words.
+  return _compiler.command(cmd);
   
 }
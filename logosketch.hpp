@@ -24,8 +24,6 @@
 #include "arduinotimeprovider.hpp"
 #include "arduinoflashstring.hpp"
 #include "arduinoflashcode.hpp"
-#include "ringbuffer.hpp"
-#include "cmd.hpp"
 
 class LogoSketch : public LogoSketchBase {
 
@@ -37,6 +35,9 @@ public:
   virtual int dosetup(const char *cmd);
   virtual int docommand(const char *cmd);
   virtual int docompile(const char *cmd) {}
+  virtual int dofeed(const char *code, short len) { return 0; }
+  virtual void doflush() {}
+  virtual int doimage(const char *data, short len) { return 0; }
   virtual Logo *logo() { return &_logo; }
 
 private:
@@ -55,6 +56,9 @@ public:
   virtual int dosetup(const char *cmd);
   virtual int docommand(const char *cmd);
   virtual int docompile(const char *cmd);
+  virtual int dofeed(const char *code, short len);
+  virtual void doflush();
+  virtual int doimage(const char *data, short len);
   virtual Logo *logo() { return &_logo; }
 
 private:
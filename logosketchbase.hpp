@@ -18,31 +18,61 @@
 #define H_logosketchbase
 
 #include "arduinotimeprovider.hpp"
-#include "ringbuffer.hpp"
-#include "cmd.hpp"
+#include "arduinoio.hpp"
+#include "logoserial.hpp"
+
+#define QUANTUM_BUCKETS     4         // quarters of the quantum
+
+typedef struct {
+  unsigned long      _loops;
+  unsigned long      _steps;
+  unsigned long      _waits; // loops that stopped early at a WAIT
+  unsigned long      _maxus; // the longest any loop took to step
+  unsigned long      _used[QUANTUM_BUCKETS]; // how many loops used each part of the quantum
+} LogoQuantumStats;
 
 class LogoSketchBase {
 
 public:
-  LogoSketchBase() : _failed(false) {}
+  LogoSketchBase() : _failed(false), _quantumsteps(1), _quantumus(0) {
+    resetquantumstats();
+  }
   
   void setup(int baud=9600);
   void loop();
+  
+  // queue up a command as if it came from the serial port.
+  void queue(const char *cmd) { _buffer.write(cmd); }
+  
+  // how much to run each loop, up to this many steps or microseconds (0 for no time
+  // limit) but always stopping at a WAIT. The default is 1 step.
+  void setquantum(short steps, unsigned long us=0);
+  const LogoQuantumStats &quantumstats() const { return _stats; }
+  void resetquantumstats();
+  void printquantumstats() const;
 
   virtual void precompile() = 0;
   virtual int dosetup(const char *cmd) = 0;
   virtual int docommand(const char *cmd) = 0;
   virtual int docompile(const char *cmd) = 0;
-  virtual Logo *logo() = 0;
+  virtual int dofeed(const char *code, short len) = 0; // a piece of a program
+  virtual void doflush() = 0; // the end of the pieces
+  virtual int doimage(const char *data, short len) = 0; // a piece of a compiled image
+  virtual LogoBase *logo() = 0;
   
 protected:
   
   ArduinoTimeProvider _time; // adds 12 bytes of dynamic memory
-  Cmd _cmd; // 32 bytes
-  char _cmdbuf[STRING_LEN]; // 32 bytes
+  ArduinoIO _io; // about 90 bytes on the AVR boards
+  LogoSerialBuffer _buffer; // SERIAL_BUFFER_LEN + 14 bytes
   bool _failed;
+  short _quantumsteps;
+  unsigned long _quantumus;
+  LogoQuantumStats _stats; // 28 bytes
   
   void showErr(int mode, int n);
+  bool readserial();
+  void updatequantumstats(short steps, unsigned long us, bool waited);
 
 };
 
@@ -0,0 +1,162 @@
+/*
+  logowifi.hpp
+  
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 19-Oct-2026
+  
+  Tiniest Logo Intepreter WIFI stuff. Everything the WIFI words need to keep
+  between calls lives in here (and so in the Logo) so that each Logo can have 
+  its own.
+      
+  This work is licensed under the Creative Commons Attribution 4.0 International License. 
+  To view a copy of this license, visit http://creativecommons.org/licenses/by/4.0/ or 
+  send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+  https://github.com/visualopsholdings/tinylogo
+*/
+
+#ifndef H_logowifi
+#define H_logowifi
+
+#ifdef ARDUINO
+#if defined(ESP32) && defined(USE_WIFI)
+#include <WiFiClientSecure.h>
+#include <SocketIOclient.h>
+#endif
+#endif
+
+#include <string.h>
+
+class LogoBase;
+
+// how much of an HTTP body we read at a time.
+#define WIFI_READ_LEN     64
+
+// the WIFI words that go to the network start a request and the task that
+// called them waits (like a WAIT) until it's done so everything else keeps going.
+#if !defined(ARDUINO) || (defined(ESP32) && defined(USE_WIFI))
+#define USE_WIFI_ASYNC
+#endif
+
+#ifdef USE_WIFI_ASYNC
+
+#ifdef USE_TASKS
+#define WIFI_REQUESTS     MAX_TASKS // one for each task
+#else
+#define WIFI_REQUESTS     1
+#endif
+
+#define WIFI_STACK        8192      // for the background task that does them on the ESP32
+
+// what the request is
+#define WIFI_REQ_GET        1
+#define WIFI_REQ_LOGIN      2
+#define WIFI_REQ_LOGINTEST  3
+#define WIFI_REQ_CONNECT    4
+
+// and where it's up to
+#define WIFI_REQ_IDLE       0
+#define WIFI_REQ_BUSY       1
+#define WIFI_REQ_DONE       2 // the result is the value
+#define WIFI_REQ_FAILED     3 // the result is the exception
+
+typedef struct {
+  volatile short     _state;
+  bool               _abandoned; // the task that wanted it has gone
+  short              _kind;
+  char               _host[64];
+  int                _port;
+  char               _arg1[128]; // the request, the user or the access point
+  char               _arg2[64];  // the field or the password
+  char               _result[256];
+  short              _resultlen;
+} LogoWifiRequest;
+
+#endif // USE_WIFI_ASYNC
+
+#ifndef ARDUINO
+// off the arduino the WIFI words use one of these instead of the network so they
+// can be tested and timed (see tools/bench.cpp).
+class LogoHttpStandIn {
+
+public:
+  virtual ~LogoHttpStandIn() {}
+  
+  // has the response come back yet.
+  virtual bool ready() { return true; }
+  
+  // start a GET and return the HTTP code.
+  virtual int get(const char *host, int port, const char *request) = 0;
+  
+  // read some more of the body, 0 when there is no more.
+  virtual int read(char *buf, int len) = 0;
+  
+  // login and return the HTTP code with the cookie in cookie.
+  virtual int login(const char *host, int port, const char *user, const char *password, char *cookie, int len) {
+    strncpy(cookie, "cookie", len);
+    return 200;
+  }
+  
+  // connect to the access point and return if it did with the IP in ip.
+  virtual bool connect(const char *ap, const char *password, char *ip, int len) {
+    strncpy(ip, "0.0.0.0", len);
+    return true;
+  }
+  
+};
+#endif
+
+class LogoWifi {
+
+public:
+#ifdef USE_WIFI_ASYNC
+  LogoWifi();
+#endif
+
+  void loop(LogoBase *logo);
+
+#ifdef USE_WIFI_ASYNC
+  // the request for the task to fill in, 0 if the last one still hasn't finished.
+  LogoWifiRequest *request(short task);
+  
+  // send it off.
+  void start(short task);
+  
+  // the task is waiting for its request.
+  bool pending(short task) const { return _requests[task]._state != WIFI_REQ_IDLE && !_requests[task]._abandoned; }
+  
+  // when the request is done push the result or throw and return true.
+  bool finish(LogoBase *logo, short task);
+  
+  // the task has gone, so has its request.
+  void cancel(short task);
+  
+  // actually do the request (in the background on the ESP32).
+  void perform(LogoWifiRequest *req);
+  
+  LogoWifiRequest _requests[WIFI_REQUESTS];
+#endif
+
+#ifdef ARDUINO
+#if defined(ESP32) && defined(USE_WIFI)
+  void event(LogoBase *logo, socketIOmessageType_t type, uint8_t *payload, size_t length);
+  
+  WiFiClientSecure _secureclient;
+  String _cookie;
+  SocketIOclient _wsclient;
+  char _msg[256]; // the open socket message.
+  
+  TaskHandle_t _worker;
+  StaticTask_t _workertask;
+  StackType_t _workerstack[WIFI_STACK];
+#endif
+#endif
+
+#ifndef ARDUINO
+  LogoHttpStandIn *_http = 0;
+  char _cookie[256];
+#endif
+
+};
+
+#endif // H_logowifi
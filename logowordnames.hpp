@@ -16,7 +16,7 @@
 #ifndef H_logowordnames
 #define H_logowordnames
 
-const char Logo::coreNames[] PROGMEM = {
+const char LogoBase::coreNames[] PROGMEM = {
   "ERR\n"
   "MAKE\n"
   "FOREVER\n"
@@ -65,10 +65,14 @@ const char Logo::coreNames[] PROGMEM = {
   "INT\n"
   "MIDINOTEON\n"
   "MIDINOTEOFF\n"
+  "PROFILE\n"
+  "TRACE\n"
+  "LAUNCH\n"
+  "WHEN\n"
 };
 
 // this arity array matches the above.
-const char Logo::coreArity[] PROGMEM = {
+const char LogoBase::coreArity[] PROGMEM = {
   0, // ERR
   2, // MAKE
   0, // FOREVER
@@ -117,10 +121,17 @@ const char Logo::coreArity[] PROGMEM = {
   1, // INT
   3, // MIDINOTEON
   3, // MIDINOTEOFF
+  0, // PROFILE
+  0, // TRACE
+  0, // LAUNCH
+  0, // WHEN
 };
 
 // these indexes match the other 2 arrays.
-void Logo::callbuiltin(short index) {
+void LogoBase::callbuiltin(short index) {
+#ifdef USE_PROFILE
+  unsigned long start = _profiling ? nowmicros() : 0;
+#endif
   switch (index) {
     case 0: LogoWords::err(*this); break;
     case 1: LogoWords::make(*this); break;
@@ -170,9 +181,18 @@ void Logo::callbuiltin(short index) {
     case 45: LogoWords::intWord(*this); break;
     case 46: LogoWords::midinoteon(*this); break;
     case 47: LogoWords::midinoteoff(*this); break;
+    case 48: LogoWords::profile(*this); break;
+    case 49: LogoWords::trace(*this); break;
+    case 50: LogoWords::launch(*this); break;
+    case 51: LogoWords::when(*this); break;
     default:
       break;
   }
+#ifdef USE_PROFILE
+  if (_profiling) {
+    profilebuiltin(index, start);
+  }
+#endif
 }
 
 #endif // H_logowordnames
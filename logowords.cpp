@@ -14,6 +14,7 @@
 #include "logowords.hpp"
 #include "logo.hpp"
 #include "logostring.hpp"
+#include "logojson.hpp"
 
 #ifdef ARDUINO
 #include <Arduino.h>
@@ -21,19 +22,11 @@
 
 #ifdef ESP32
 
-char gBuff[256]; // a generic buffer
-#include "ringbuffer.hpp"
-extern RingBuffer gBuffer;
+#include "logosketchbase.hpp"
 
 #ifdef USE_WIFI
 #include <WiFi.h>
-#include <WiFiClientSecure.h>
 #include <HTTPClient.h>
-WiFiClientSecure gSecureClient;
-String gCookie;
-#include <SocketIOclient.h>
-SocketIOclient gWSClient;
-char gMsg[256]; // the open socket message.
 #endif // USE_WIFI
 
 #endif // ESP32
@@ -45,10 +38,6 @@ char gMsg[256]; // the open socket message.
 
 #endif
 
-#ifdef USE_JSON
-#include <ArduinoJson.h>
-#endif
-
 #ifdef USE_MIDI
 #ifdef USE_USBHOSTMIDI
 #include "MIDIUSB.h"
@@ -57,13 +46,13 @@ char gMsg[256]; // the open socket message.
 
 using namespace std;
 
-void LogoWords::err(Logo &logo) {
+void LogoWords::err(LogoBase &logo) {
 
   logo.fail(LG_STOP);
   
 }
 
-void LogoWords::make(Logo &logo) {
+void LogoWords::make(LogoBase &logo) {
 
   if (logo.isstackint()) {
   
@@ -85,7 +74,17 @@ void LogoWords::make(Logo &logo) {
     LogoStringResult result;
     logo.popstring(&result);
     short var = logo.findvariable(&result);
-    if (var < 0) {
+    short n;
+    if (logo.intstring(&value, &n)) {
+      // store it as the number so it never needs parsing again.
+      if (var < 0) {
+        var = logo.newintvar(logo.addstring(&result), result.length(), n);
+      }
+      else {
+        logo.setintvar(var, n);    
+      }
+    }
+    else if (var < 0) {
       var = logo.newstringvar(logo.addstring(&result), result.length(), logo.addstring(&value), value.length());
     }
     else {
@@ -121,7 +120,7 @@ void LogoWords::make(Logo &logo) {
   
 }
 
-void LogoWords::thing(Logo &logo) {
+void LogoWords::thing(LogoBase &logo) {
 
   LogoStringResult result;
   logo.popstring(&result);
@@ -135,14 +134,14 @@ void LogoWords::thing(Logo &logo) {
 
 }
 
-void LogoWords::forever(Logo &logo) {
+void LogoWords::forever(LogoBase &logo) {
 
   // change the next return address to be 1 minus what we have 
   logo.modifyreturn(-1, -1);
 
 }
 
-void LogoWords::repeat(Logo &logo) {
+void LogoWords::repeat(LogoBase &logo) {
 
   short n = logo.popint();
 
@@ -151,7 +150,7 @@ void LogoWords::repeat(Logo &logo) {
 
 }
 
-bool LogoWords::pushliterals(Logo &logo, short rel) {
+bool LogoWords::pushliterals(LogoBase &logo, short rel) {
 
   if (logo.codeisint(rel)) {
     logo.pushint(logo.codetoint(rel));
@@ -171,7 +170,7 @@ bool LogoWords::pushliterals(Logo &logo, short rel) {
   
 }
 
-void LogoWords::ifelse(Logo &logo) {
+void LogoWords::ifelse(LogoBase &logo) {
 
 //  logo.dump("ifelse", false);
   
@@ -204,7 +203,7 @@ void LogoWords::ifelse(Logo &logo) {
     
 }
 
-void LogoWords::ifWord(Logo &logo) {
+void LogoWords::ifWord(LogoBase &logo) {
 
   // this is a very special trick to allow us to manipulate the PC
   // based on the value of the stack.
@@ -226,26 +225,44 @@ void LogoWords::ifWord(Logo &logo) {
 
 }
 
-void LogoWords::wait(Logo &logo) {
+void LogoWords::wait(LogoBase &logo) {
 
   // schedule the next word to execute after a certain time.
   logo.schedulenext(logo.popint());
   
 }
 
-void LogoWords::eq(Logo &logo) {
+void LogoWords::eq(LogoBase &logo) {
+
+  short n1, n2;
+  if (logo.popints(&n1, &n2)) {
+    logo.pushint(n2 == n1);
+    return;
+  }
 
   logo.pushint(logo.popint() == logo.popint());
   
 }
 
-void LogoWords::neq(Logo &logo) {
+void LogoWords::neq(LogoBase &logo) {
+
+  short n1, n2;
+  if (logo.popints(&n1, &n2)) {
+    logo.pushint(n2 != n1);
+    return;
+  }
 
   logo.pushint(logo.popint() != logo.popint());
   
 }
 
-void LogoWords::gt(Logo &logo) {
+void LogoWords::gt(LogoBase &logo) {
+
+  short n1, n2;
+  if (logo.popints(&n1, &n2)) {
+    logo.pushint(n2 > n1);
+    return;
+  }
 
   // args are backwards.
   double i1 = logo.popdouble();
@@ -254,7 +271,13 @@ void LogoWords::gt(Logo &logo) {
   
 }
 
-void LogoWords::lt(Logo &logo) {
+void LogoWords::lt(LogoBase &logo) {
+
+  short n1, n2;
+  if (logo.popints(&n1, &n2)) {
+    logo.pushint(n2 < n1);
+    return;
+  }
 
   // args are backwards.
   double i1 = logo.popdouble();
@@ -263,7 +286,13 @@ void LogoWords::lt(Logo &logo) {
   
 }
 
-void LogoWords::gte(Logo &logo) {
+void LogoWords::gte(LogoBase &logo) {
+
+  short n1, n2;
+  if (logo.popints(&n1, &n2)) {
+    logo.pushint(n2 >= n1);
+    return;
+  }
 
   // args are backwards.
   double i1 = logo.popdouble();
@@ -272,7 +301,13 @@ void LogoWords::gte(Logo &logo) {
   
 }
 
-void LogoWords::lte(Logo &logo) {
+void LogoWords::lte(LogoBase &logo) {
+
+  short n1, n2;
+  if (logo.popints(&n1, &n2)) {
+    logo.pushint(n2 <= n1);
+    return;
+  }
 
   // args are backwards.
   double i1 = logo.popdouble();
@@ -281,13 +316,19 @@ void LogoWords::lte(Logo &logo) {
   
 }
 
-void LogoWords::notWord(Logo &logo) {
+void LogoWords::notWord(LogoBase &logo) {
 
   logo.pushint(!logo.popint());
   
 }
 
-void LogoWords::subtract(Logo &logo) {
+void LogoWords::subtract(LogoBase &logo) {
+
+  short n1, n2;
+  if (logo.popints(&n1, &n2)) {
+    logo.pushint(n2 - n1);
+    return;
+  }
 
   // args are backwards.
   double a1 = logo.popdouble();
@@ -296,7 +337,13 @@ void LogoWords::subtract(Logo &logo) {
   
 }
 
-void LogoWords::add(Logo &logo) {
+void LogoWords::add(LogoBase &logo) {
+
+  short n1, n2;
+  if (logo.popints(&n1, &n2)) {
+    logo.pushint(n2 + n1);
+    return;
+  }
 
   double a1 = logo.popdouble();
   double a2 = logo.popdouble();
@@ -304,7 +351,7 @@ void LogoWords::add(Logo &logo) {
   
 }
 
-void LogoWords::divide(Logo &logo) {
+void LogoWords::divide(LogoBase &logo) {
 
   double a1 = logo.popdouble();
   double a2 = logo.popdouble();
@@ -316,7 +363,13 @@ void LogoWords::divide(Logo &logo) {
   
 }
 
-void LogoWords::multiply(Logo &logo) {
+void LogoWords::multiply(LogoBase &logo) {
+
+  short n1, n2;
+  if (logo.popints(&n1, &n2)) {
+    logo.pushint(n2 * n1);
+    return;
+  }
 
   double a1 = logo.popdouble();
   double a2 = logo.popdouble();
@@ -324,7 +377,7 @@ void LogoWords::multiply(Logo &logo) {
   
 }
 
-void LogoWords::dumpvars(Logo &logo) {
+void LogoWords::dumpvars(LogoBase &logo) {
 
 #ifndef ARDUINO
   logo.dumpvars();
@@ -332,12 +385,32 @@ void LogoWords::dumpvars(Logo &logo) {
     
 }
 
-void LogoWords::print(Logo &logo) {
+void LogoWords::printresult(LogoBase &logo, LogoStringResult *result) {
+
+  // straight out without copying into a buffer first.
+  if (result->_fixed) {
+    for (short i=0; i<result->_fixedlen; i++) {
+#ifdef ARDUINO
+      Serial.write((*result->_fixed)[result->_fixedstart + i]);
+#else
+      logo.out() << (*result->_fixed)[result->_fixedstart + i];
+#endif
+    }
+    return;
+  }
+#ifdef ARDUINO
+  Serial.write((const uint8_t *)result->_simple.c_str(), result->_simple.length());
+#else
+  logo.out().write(result->_simple.c_str(), result->_simple.length());
+#endif
+
+}
+
+void LogoWords::print(LogoBase &logo) {
 
 //  logo.dumpstack(0, false);
 
   LogoStringResult result;
-  char s[256];
 
   if (logo.isstacklist()) {
     List l = logo.poplist();
@@ -349,43 +422,44 @@ void LogoWords::print(Logo &logo) {
     bool first = true;
     while (l.iter(&node, &val)) {
       if (logo.getlistval(val, &result)) {
-        result.ncpy(s, sizeof(s));
         if (!first) {
 #ifdef ARDUINO
           Serial.print(' ');
-          Serial.flush();
 #else
           logo.out() << " ";
 #endif
         }
-#ifdef ARDUINO
-        Serial.print(s);
-        Serial.flush();
-#else
-        logo.out() << s;
-#endif
+        printresult(logo, &result);
       }
       first = false;
     }
-#ifndef ARDUINO
+#ifdef ARDUINO
+    Serial.flush();
+#else
     logo.out() << endl;
 #endif
   }
   else {
     logo.popstring(&result);
-    result.ncpy(s, sizeof(s));
 #ifdef ARDUINO
-    Serial.println(s);
+    printresult(logo, &result);
+    Serial.println();
     Serial.flush();
 #else
-    logo.out() << "=== " << s << endl;
+    logo.out() << "=== ";
+    printresult(logo, &result);
+    logo.out() << endl;
 #endif
   }
 }
 
-void LogoWords::dread(Logo &logo) {
+void LogoWords::dread(LogoBase &logo) {
 
   int pin = logo.popint();
+  if (logo.io()) {
+    logo.pushint(logo.io()->dread(pin));
+    return;
+  }
 #ifdef ARDUINO
   logo.pushint(digitalRead(pin));
 #else
@@ -395,9 +469,13 @@ void LogoWords::dread(Logo &logo) {
   
 }
 
-void LogoWords::dhigh(Logo &logo) {
+void LogoWords::dhigh(LogoBase &logo) {
 
   int pin = logo.popint();
+  if (logo.io()) {
+    logo.io()->dwrite(pin, true);
+    return;
+  }
 #ifdef ARDUINO
   digitalWrite(pin, HIGH);
 #else
@@ -406,9 +484,13 @@ void LogoWords::dhigh(Logo &logo) {
   
 }
 
-void LogoWords::dlow(Logo &logo) {
+void LogoWords::dlow(LogoBase &logo) {
 
   int pin = logo.popint();
+  if (logo.io()) {
+    logo.io()->dwrite(pin, false);
+    return;
+  }
 #ifdef ARDUINO
   digitalWrite(pin, LOW);
 #else
@@ -417,9 +499,13 @@ void LogoWords::dlow(Logo &logo) {
   
 }
 
-void LogoWords::pinout(Logo &logo) {
+void LogoWords::pinout(LogoBase &logo) {
 
   int pin = logo.popint();
+  if (logo.io()) {
+    logo.io()->pinmode(pin, IO_OUTPUT);
+    return;
+  }
 #ifdef ARDUINO
   pinMode(pin, OUTPUT);
 #else
@@ -428,9 +514,13 @@ void LogoWords::pinout(Logo &logo) {
   
 }
 
-void LogoWords::pinin(Logo &logo) {
+void LogoWords::pinin(LogoBase &logo) {
 
   int pin = logo.popint();
+  if (logo.io()) {
+    logo.io()->pinmode(pin, IO_INPUT);
+    return;
+  }
 #ifdef ARDUINO
   pinMode(pin, INPUT);
 #else
@@ -439,9 +529,13 @@ void LogoWords::pinin(Logo &logo) {
   
 }
 
-void LogoWords::pininup(Logo &logo) {
+void LogoWords::pininup(LogoBase &logo) {
 
   int pin = logo.popint();
+  if (logo.io()) {
+    logo.io()->pinmode(pin, IO_INPUT_PULLUP);
+    return;
+  }
 #ifdef ARDUINO
   pinMode(pin, INPUT_PULLUP);
 #else
@@ -450,10 +544,14 @@ void LogoWords::pininup(Logo &logo) {
   
 }
 
-void LogoWords::aout(Logo &logo) {
+void LogoWords::aout(LogoBase &logo) {
 
   int value = logo.popint();
   int pin = logo.popint();
+  if (logo.io()) {
+    logo.io()->awrite(pin, value);
+    return;
+  }
 #ifdef ARDUINO
 #ifdef __AVR__
   analogWrite(pin, value);
@@ -466,13 +564,17 @@ void LogoWords::aout(Logo &logo) {
   
 }
 
-void LogoWords::pinrgb(Logo &logo) {
+void LogoWords::pinrgb(LogoBase &logo) {
 
   int channel = logo.popint();
   int pin = logo.popint();
   
   logo.setpin(channel, pin);
   
+  if (logo.io()) {
+    logo.io()->rgbpin(channel, pin);
+    return;
+  }
 #ifdef ARDUINO
 #ifdef ESP32
   ledcSetup(channel, 12000, 8); // 12 kHz PWM, 8-bit resolution
@@ -487,13 +589,17 @@ void LogoWords::pinrgb(Logo &logo) {
   
 }
 
-void LogoWords::rgbout(Logo &logo) {
+void LogoWords::rgbout(LogoBase &logo) {
 
   int value = logo.popint();
   int channel = logo.popint();
   
   int pin = logo.getpin(channel);
   
+  if (logo.io()) {
+    logo.io()->rgbwrite(channel, pin, value);
+    return;
+  }
 #ifdef ARDUINO
 #ifdef ESP32
   ledcWrite(channel, value);
@@ -507,13 +613,13 @@ void LogoWords::rgbout(Logo &logo) {
   
 }
 
-void LogoWords::output(Logo &logo) {
+void LogoWords::output(LogoBase &logo) {
 
   // just leaves whatever is on the stack on the stack.
   
 }
 
-void LogoWords::wordWord(Logo &logo) {
+void LogoWords::wordWord(LogoBase &logo) {
 
   LogoStringResult s1;
   logo.popstring(&s1);
@@ -528,7 +634,7 @@ void LogoWords::wordWord(Logo &logo) {
   
 }
 
-void LogoWords::first(Logo &logo) {
+void LogoWords::first(LogoBase &logo) {
 
   LogoStringResult str;
   logo.popstring(&str);
@@ -541,7 +647,7 @@ void LogoWords::first(Logo &logo) {
   
 }
 
-void LogoWords::type(Logo &logo) {
+void LogoWords::type(LogoBase &logo) {
 
   if (logo.isstacklist()) {
     LogoSimpleString str("LIST");
@@ -571,31 +677,31 @@ void LogoWords::type(Logo &logo) {
   
 }
 
-void LogoWords::machineinfo(Logo &logo) {
+void LogoWords::machineinfo(LogoBase &logo) {
 
 #ifdef ARDUINO
     Serial.print("TinyLogo version ");
     Serial.println(MACHINE_VERSION);
     Serial.print("Strings: ");
-    Serial.println(STRING_POOL_SIZE);
+    Serial.println(logo.poolsize());
     Serial.print("Code: ");
-    Serial.println(CODE_SIZE);
+    Serial.println(logo.codesize());
     Serial.print("Stack: ");
-    Serial.println(MAX_STACK);
+    Serial.println(logo.maxstack());
     Serial.print("Vars: ");
-    Serial.println(MAX_VARS);
+    Serial.println(logo.maxvars());
     Serial.flush();
 #else
     logo.out() << "TinyLogo" << endl;
-    logo.out() << "Strings: " << STRING_POOL_SIZE << endl;
-    logo.out() << "Code: " << CODE_SIZE << endl;
-    logo.out() << "Stack: " << MAX_STACK << endl;
-    logo.out() << "Vars: " << MAX_VARS << endl;
+    logo.out() << "Strings: " << logo.poolsize() << endl;
+    logo.out() << "Code: " << logo.codesize() << endl;
+    logo.out() << "Stack: " << logo.maxstack() << endl;
+    logo.out() << "Vars: " << logo.maxvars() << endl;
 #endif
  
 }
 
-void LogoWords::wifistation(Logo &logo) {
+void LogoWords::wifistation(LogoBase &logo) {
 
 #ifdef ARDUINO
 #if defined(ESP32) && defined(USE_WIFI)
@@ -607,7 +713,37 @@ void LogoWords::wifistation(Logo &logo) {
 
 }
 
-void LogoWords::wificonnect(Logo &logo) {
+#ifdef USE_WIFI_ASYNC
+// the task that's running (and so calling the word).
+static short thistask(LogoBase &logo) {
+
+#ifdef USE_TASKS
+  return logo.currenttask();
+#else
+  return 0;
+#endif
+
+}
+
+// the request for this task, it throws if there isn't one.
+static LogoWifiRequest *wifirequest(LogoBase &logo, short kind) {
+
+  LogoWifiRequest *req = logo._wifi.request(thistask(logo));
+  if (!req) {
+    logo.throwException("Wifi busy");
+    return 0;
+  }
+  req->_kind = kind;
+  req->_host[0] = 0;
+  req->_port = 0;
+  req->_arg1[0] = 0;
+  req->_arg2[0] = 0;
+  return req;
+  
+}
+#endif
+
+void LogoWords::wificonnect(LogoBase &logo) {
 
   LogoStringResult password;
   logo.popstring(&password);
@@ -615,92 +751,28 @@ void LogoWords::wificonnect(Logo &logo) {
   LogoStringResult ap;
   logo.popstring(&ap);
   
-#ifdef ARDUINO
-#if defined(ESP32) && defined(USE_WIFI)
-
-  // we put the SSID in gBuff, and need a password buffer.
-  char passbuf[128];
-    
-  password.ncpyesc(passbuf, sizeof(passbuf));
-  ap.ncpyesc(gBuff, sizeof(gBuff));
-
-  Serial.print("Wifi: Connecting [");
-  Serial.print(gBuff);
-  Serial.print("] [");
-  Serial.print(passbuf);
-  Serial.println("]");
-  
-  WiFi.begin(gBuff, passbuf);
-  bool finished = false;
-  bool success = false;
-  int discon = 0;
-  int i=0;
-  while (!finished && i<100) {
-    int status = WiFi.status();
-    switch (status) {
-    case WL_CONNECTED:
-      finished = true;
-      success = true;
-      break;
-    case WL_IDLE_STATUS:
-      Serial.print('.');
-      break;
-    case WL_DISCONNECTED:
-      Serial.print('-');
-      discon++;
-      break;
-    case WL_CONNECT_FAILED:
-      logo.throwException("Connect failed");
-      finished = true;
-      break;
-    case WL_CONNECTION_LOST:
-      logo.throwException("Connection lost");
-      finished = true;
-      break;
-    case WL_NO_SHIELD:
-      logo.throwException("No Wifi Shield");
-      finished = true;
-      break;
-    case WL_NO_SSID_AVAIL:
-      logo.throwException("No SSID available");
-      finished = true;
-      break;
-    default:
-      Serial.print("Unknown status ");
-      Serial.println(status);
-    }
-    delay(400);
-    i++;
-    if ((i % 80) == 0) {
-      Serial.println();
-    }
-    // every 20 disconects, try to connect again.
-    if (discon > 20) {
-      Serial.print('+');
-      WiFi.disconnect();
-      WiFi.begin(gBuff, passbuf);
-      discon = 0;
-    }
-  };
-  if (!success) {
-    if (!finished) {
-      logo.throwException("Connection timed out");
-    }
+#ifdef USE_WIFI_ASYNC
+#ifndef ARDUINO
+  if (!logo._wifi._http) {
+    LogoSimpleString str("0.0.0.0");
+    logo.pushstring(&str);
     return;
   }
-  LogoSimpleString str(WiFi.localIP().toString().c_str());
-  logo.pushstring(&str);
-#else
-  logo.throwException("Wifi not supported");
 #endif
+  LogoWifiRequest *req = wifirequest(logo, WIFI_REQ_CONNECT);
+  if (!req) {
+    return;
+  }
+  ap.ncpyesc(req->_arg1, sizeof(req->_arg1));
+  password.ncpyesc(req->_arg2, sizeof(req->_arg2));
+  logo._wifi.start(thistask(logo));
 #else
-  LogoSimpleString str("0.0.0.0");
-  logo.pushstring(&str);
+  logo.throwException("Wifi not supported");
 #endif
 
 }
 
-void LogoWords::wifiscan(Logo &logo) {
+void LogoWords::wifiscan(LogoBase &logo) {
 
   List l = logo.newlist();
   
@@ -727,7 +799,7 @@ void LogoWords::wifiscan(Logo &logo) {
   
 }
 
-void LogoWords::wifiget(Logo &logo) {
+void LogoWords::wifiget(LogoBase &logo) {
 
   LogoStringResult field;
   logo.popstring(&field);
@@ -740,155 +812,97 @@ void LogoWords::wifiget(Logo &logo) {
   LogoStringResult host;
   logo.popstring(&host);
   
-#ifdef ARDUINO
-#if defined(ESP32) && defined(USE_WIFI)
-  
-  if (WiFi.status() != WL_CONNECTED) {
-    logo.throwException("Wifi not connected");
-    return;
-  }
-  
-  HTTPClient http;
-
-  host.ncpy(gBuff, sizeof(gBuff));
-
-  if (port == 443 || port == 8443) {
-
-    if (gSecureClient.connect(gBuff, port) < 0) {
-      gSecureClient.lastError(gBuff, sizeof(gBuff));
-      logo.throwException(gBuff);
-      return;
-    }
-
-    strcpy(gBuff, "https://");
-    int len = strlen(gBuff);
-    host.ncpy(gBuff + len, sizeof(gBuff) - len);
-    if (port != 443) {
-      strcat(gBuff, ":");
-      int len = strlen(gBuff);
-      snprintf(gBuff + len, sizeof(gBuff) - len, "%d", port);
-    }
-    len = strlen(gBuff);
-    request.ncpy(gBuff + len, sizeof(gBuff) - len);
-
-    if (!http.begin(gSecureClient, gBuff)) {
-      logo.throwException("Failed to begin request");
-      return;
-    }
-  }
-  else {
-    strcpy(gBuff, "http://");
-    int len = strlen(gBuff);
-    host.ncpy(gBuff + len, sizeof(gBuff) - len);
-    if (port != 80) {
-      strcat(gBuff, ":");
-      int len = strlen(gBuff);
-      snprintf(gBuff + len, sizeof(gBuff) - len, "%d", port);
-    }
-    len = strlen(gBuff);
-    request.ncpy(gBuff + len, sizeof(gBuff) - len);
-    
-    if (!http.begin(gBuff)) {
-      logo.throwException("Failed to begin request");
-      return;
-    }
-  }
-  
-  http.addHeader("Cookie", gCookie);   
-  
-  int code = http.GET();
-  if (code <= 0) {
-    Serial.print("HTTPClient: ");
-    Serial.println(code);
-    logo.throwException("HTTP failed");
-    return;
-  }
-  
-  if (code != HTTP_CODE_OK && code != 302) {
-    strcpy(gBuff, "HTTP Error ");
-    int len = strlen(gBuff);
-    snprintf(gBuff + len, sizeof(gBuff) - len, "%d", code);
-    logo.throwException(gBuff);
+#ifdef USE_WIFI_ASYNC
+#ifndef ARDUINO
+  if (!logo._wifi._http) {
+    LogoSimpleString str("Wifi Sending");
+    logo.pushstring(&str);
     return;
   }
-  
-  // get result and convert to JSON.
-  String result = http.getString();
-  DynamicJsonDocument doc(result.length());
-  deserializeJson(doc, result.c_str());
-  
-  // return the field requested
-  field.ncpy(gBuff, sizeof(gBuff));
-  const char *val = doc[gBuff];
-  if (!val) {
-    logo.throwException("Field not found");
+#endif
+  LogoWifiRequest *req = wifirequest(logo, WIFI_REQ_GET);
+  if (!req) {
     return;
   }
-
-  LogoSimpleString str(val);
-  logo.pushstring(&str);  
+  host.ncpy(req->_host, sizeof(req->_host));
+  req->_port = port;
+  request.ncpy(req->_arg1, sizeof(req->_arg1));
+  field.ncpy(req->_arg2, sizeof(req->_arg2));
+  logo._wifi.start(thistask(logo));
 #else
   logo.throwException("Wifi not supported");
 #endif
-#else
-  LogoSimpleString str("Wifi Sending");
-  logo.pushstring(&str);
-#endif // ARDUINO
 
 }
 
 bool LogoWords::extractEventName(LogoSimpleString *s, char *name, int namelen) {
 
-#ifdef USE_JSON
-  DynamicJsonDocument doc(256);
-  deserializeJson(doc, s->c_str());
-
-  if (!doc.is<JsonArray>()) {
+  // a Socket.IO event is ["name", ...] and that's all we need of it so just
+  // look for the first string rather than parse it all.
+  short len = s->length();
+  short i = 0;
+  while (i < len && ((*s)[i] == ' ' || (*s)[i] == '\t' || (*s)[i] == '\r' || (*s)[i] == '\n')) {
+    i++;
+  }
+  if (i >= len || (*s)[i] != '[') {
     return false;
   }
-  JsonArray arr = doc.as<JsonArray>();
-  if (arr.size() < 2) {
+  i++;
+  while (i < len && ((*s)[i] == ' ' || (*s)[i] == '\t' || (*s)[i] == '\r' || (*s)[i] == '\n')) {
+    i++;
+  }
+  if (i >= len || (*s)[i] != '"') {
     return false;
   }
-  if (!arr[0].is<const char *>()) {
+  i++;
+  short n = 0;
+  while (i < len && (*s)[i] != '"') {
+    if ((*s)[i] == '\\') {
+      i++;
+      if (i >= len) {
+        return false;
+      }
+    }
+    if (n >= namelen - 1) {
+      return false;
+    }
+    name[n++] = (*s)[i++];
+  }
+  if (i >= len) {
     return false;
   }
+  name[n] = 0;
   
-  const char *n = arr[0].as<const char *>();
-  int len = strlen(n);
-  if (namelen < len) {
-    return false;
+  // and there has to be something after it.
+  i++;
+  while (i < len && ((*s)[i] == ' ' || (*s)[i] == '\t' || (*s)[i] == '\r' || (*s)[i] == '\n')) {
+    i++;
   }
-  strcpy(name, n);
-    
-  return true;
-#else
-  return false;
-#endif
+  return i < len && (*s)[i] == ',';
+  
 }
 
 #ifdef ARDUINO
 #if defined(ESP32) && defined(USE_WIFI)
-void webSocketEvent(socketIOmessageType_t type, uint8_t * payload, size_t length) {
+void LogoWifi::event(LogoBase *logo, socketIOmessageType_t type, uint8_t * payload, size_t length) {
 
   switch (type) {
 
     case sIOtype_CONNECT:
       {
-        if (gMsg[0]) {
-          gWSClient.sendEVENT(gMsg);
+        if (_msg[0]) {
+          _wsclient.sendEVENT(_msg);
         }
       }
       break;
       
     case sIOtype_EVENT:
       {
-        char s[32];
+        // just the name, the Logo runs the word for it (see WHEN).
+        char s[EVENT_NAME_LEN];
         LogoSimpleString evt((const char*)payload, length);
         if (LogoWords::extractEventName(&evt, s, sizeof(s))) {
-          if (strcmp(s, "update") == 0) {
-            gBuffer.write("FLASH\n");
-          }
+          logo->_events.push(s, strlen(s), (const char *)payload, length);
         }
       }
       break;
@@ -899,120 +913,327 @@ void webSocketEvent(socketIOmessageType_t type, uint8_t * payload, size_t length
 #endif
 #endif
 
-void LogoWords::wifisockets(Logo &logo) {
+void LogoWifi::loop(LogoBase *logo) {
 
-  LogoStringResult openmsg;
-  logo.popstring(&openmsg);
-  
-  int port = logo.popint();
-  
-  LogoStringResult host;
-  logo.popstring(&host);
-  
 #ifdef ARDUINO
 #if defined(ESP32) && defined(USE_WIFI)
+  // let the websockets client check for incoming messages, but not until
+  // there is room for them.
+  if (!logo->_events.full()) {
+    _wsclient.loop();
+  }
+#endif
+#endif
 
-  host.ncpy(gBuff, sizeof(gBuff));
-  openmsg.ncpy(gMsg, sizeof(gMsg));
-
-	if (port == 443 || port == 8443) {
-    gWSClient.beginSSL(gBuff, port);
-	}
-	else {
-    gWSClient.begin(gBuff, port);
-	}
+}
 
-	// event handler
-	gWSClient.onEvent(webSocketEvent);
+#ifdef USE_WIFI_ASYNC
+
+#if defined(ARDUINO) && defined(ESP32)
+// does the requests one after the other in the background.
+static void wifiworker(void *param) {
+
+  LogoWifi *wifi = (LogoWifi *)param;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    for (short i=0; i<WIFI_REQUESTS; i++) {
+      LogoWifiRequest *req = &wifi->_requests[i];
+      if (req->_state == WIFI_REQ_BUSY) {
+        wifi->perform(req);
+        if (req->_abandoned) {
+          req->_abandoned = false;
+          req->_state = WIFI_REQ_IDLE;
+        }
+      }
+    }
+  }
+  
+}
+#endif
 
-  strcpy(gBuff, "Cookie: ");
-  strcat(gBuff, gCookie.c_str());
-  gWSClient.setExtraHeaders(gBuff);
+LogoWifi::LogoWifi() {
 
-	// try ever 5000 again if connection has failed
-  gWSClient.setReconnectInterval(5000);
-#else
-  logo.throwException("Wifi not supported");
+  for (short i=0; i<WIFI_REQUESTS; i++) {
+    _requests[i]._state = WIFI_REQ_IDLE;
+    _requests[i]._abandoned = false;
+  }
+#if defined(ARDUINO) && defined(ESP32)
+  _worker = 0;
+#endif
+#ifndef ARDUINO
+  _cookie[0] = 0;
 #endif
-#else
-  logo.out() << "Wifi Sockets " << endl;
-#endif // ARDUINO
 
 }
 
-void LogoWords::vopsopenmsg(Logo &logo) {
+LogoWifiRequest *LogoWifi::request(short task) {
 
-  LogoStringResult docid;
-  logo.popstring(&docid);
+  // one that was abandoned might still be going.
+  if (_requests[task]._state != WIFI_REQ_IDLE) {
+    return 0;
+  }
+  return &_requests[task];
   
-  LogoStringResult userid;
-  logo.popstring(&userid);
+}
+
+void LogoWifi::start(short task) {
+
+  _requests[task]._abandoned = false;
+  _requests[task]._state = WIFI_REQ_BUSY;
   
-#ifdef ARDUINO
-#if defined(ESP32) && defined(USE_WIFI)
-  strcpy(gBuff, "[ \"openDocuments\", { \"docs\": [ { \"id\": \"");
-  int len = strlen(gBuff);
-  docid.ncpy(gBuff + len, sizeof(gBuff) - len);
-  strcat(gBuff, "\", \"type\": \"stream\" } ], \"userid\": \"");
-  len = strlen(gBuff);
-  userid.ncpy(gBuff + len, sizeof(gBuff) - len);
-  strcat(gBuff, "\" } ]");
-
-  LogoSimpleString s(gBuff);
-  logo.pushstring(&s);
-#else
-  logo.throwException("Wifi not supported");
-#endif
-#else
-  LogoSimpleString s("Make open message");
-  logo.pushstring(&s);
+#if defined(ARDUINO) && defined(ESP32)
+  if (!_worker) {
+    _worker = xTaskCreateStaticPinnedToCore(wifiworker, "wifi", WIFI_STACK, this, 1, _workerstack, &_workertask, 0);
+  }
+  xTaskNotifyGive(_worker);
 #endif
-  
+
 }
 
-void LogoWords::wifilogintest(Logo &logo) {
+bool LogoWifi::finish(LogoBase *logo, short task) {
 
-  LogoStringResult username;
-  logo.popstring(&username);
+  LogoWifiRequest *req = &_requests[task];
   
-  int port = logo.popint();
+#ifndef ARDUINO
+  // the stand in does it all at once when it's ready.
+  if (req->_state == WIFI_REQ_BUSY && _http && _http->ready()) {
+    perform(req);
+  }
+#endif
+
+  if (req->_state == WIFI_REQ_BUSY) {
+    return false;
+  }
+  if (req->_state == WIFI_REQ_DONE) {
+    LogoSimpleString str(req->_result, req->_resultlen);
+    logo->pushstring(&str);
+  }
+  else {
+    logo->throwException(req->_result);
+  }
+  req->_state = WIFI_REQ_IDLE;
+  return true;
   
-  LogoStringResult host;
-  logo.popstring(&host);
+}
+
+void LogoWifi::cancel(short task) {
+
+  LogoWifiRequest *req = &_requests[task];
+#if defined(ARDUINO) && defined(ESP32)
+  // the worker has it, it will let it go when it's done.
+  if (req->_state == WIFI_REQ_BUSY) {
+    req->_abandoned = true;
+    return;
+  }
+#endif
+  req->_state = WIFI_REQ_IDLE;
   
+}
+
+// the request is done with this as the result.
+static void wifidone(LogoWifiRequest *req, short state, const char *s) {
+
+  strncpy(req->_result, s, sizeof(req->_result) - 1);
+  req->_result[sizeof(req->_result) - 1] = 0;
+  req->_resultlen = strlen(req->_result);
+  req->_state = state;
+  
+}
+
+static void wifihttperror(LogoWifiRequest *req, int code) {
+
+  char buf[32];
+  snprintf(buf, sizeof(buf), "HTTP Error %d", code);
+  wifidone(req, WIFI_REQ_FAILED, buf);
+  
+}
+
+// the field we pulled out of the body is already in the result, or why not.
+static void wififield(LogoWifiRequest *req, short result, short len) {
+
+  switch (result) {
+    case JSON_FOUND:
+      req->_resultlen = len;
+      req->_state = WIFI_REQ_DONE;
+      break;
+    case JSON_TOO_LONG:
+      wifidone(req, WIFI_REQ_FAILED, "Field too long");
+      break;
+    case JSON_BAD:
+      wifidone(req, WIFI_REQ_FAILED, "Bad JSON");
+      break;
+    default:
+      wifidone(req, WIFI_REQ_FAILED, "Field not found");
+      break;
+  }
+  
+}
+
 #ifdef ARDUINO
-#if defined(ESP32) && defined(USE_WIFI)
 
-  if (WiFi.status() != WL_CONNECTED) {
-    logo.throwException("Wifi not connected");
-     return;
+// the URL in buf.
+static void wifiurl(char *buf, int len, bool secure, LogoWifiRequest *req, const char *path) {
+
+  strcpy(buf, secure ? "https://" : "http://");
+  strncat(buf, req->_host, len - strlen(buf) - 1);
+  if (req->_port != (secure ? 443 : 80)) {
+    int l = strlen(buf);
+    snprintf(buf + l, len - l, ":%d", req->_port);
   }
+  strncat(buf, path, len - strlen(buf) - 1);
   
-  if (port == 443 || port == 8443) {
-    logo.throwException("Test login is not secure.");
-    return;
+}
+
+static void wifiperformconnect(LogoWifi *wifi, LogoWifiRequest *req) {
+
+  Serial.print("Wifi: Connecting [");
+  Serial.print(req->_arg1);
+  Serial.print("] [");
+  Serial.print(req->_arg2);
+  Serial.println("]");
+  
+  WiFi.begin(req->_arg1, req->_arg2);
+  int discon = 0;
+  for (int i=0; i<100; i++) {
+    int status = WiFi.status();
+    switch (status) {
+    case WL_CONNECTED:
+      wifidone(req, WIFI_REQ_DONE, WiFi.localIP().toString().c_str());
+      return;
+    case WL_IDLE_STATUS:
+      Serial.print('.');
+      break;
+    case WL_DISCONNECTED:
+      Serial.print('-');
+      discon++;
+      break;
+    case WL_CONNECT_FAILED:
+      wifidone(req, WIFI_REQ_FAILED, "Connect failed");
+      return;
+    case WL_CONNECTION_LOST:
+      wifidone(req, WIFI_REQ_FAILED, "Connection lost");
+      return;
+    case WL_NO_SHIELD:
+      wifidone(req, WIFI_REQ_FAILED, "No Wifi Shield");
+      return;
+    case WL_NO_SSID_AVAIL:
+      wifidone(req, WIFI_REQ_FAILED, "No SSID available");
+      return;
+    default:
+      Serial.print("Unknown status ");
+      Serial.println(status);
+    }
+    // only this task waits.
+    delay(400);
+    if (((i + 1) % 80) == 0) {
+      Serial.println();
+    }
+    // every 20 disconects, try to connect again.
+    if (discon > 20) {
+      Serial.print('+');
+      WiFi.disconnect();
+      WiFi.begin(req->_arg1, req->_arg2);
+      discon = 0;
+    }
   }
+  wifidone(req, WIFI_REQ_FAILED, "Connection timed out");
+
+}
+
+static void wifiperformget(LogoWifi *wifi, LogoWifiRequest *req) {
+
+  char buf[256]; // a generic buffer
   
   HTTPClient http;
+  
+  // so the body isn't chunked and we can just parse it as it comes.
+  http.useHTTP10(true);
 
-  host.ncpy(gBuff, sizeof(gBuff));
+  bool secure = req->_port == 443 || req->_port == 8443;
+  if (secure) {
+    if (wifi->_secureclient.connect(req->_host, req->_port) < 0) {
+      wifi->_secureclient.lastError(buf, sizeof(buf));
+      wifidone(req, WIFI_REQ_FAILED, buf);
+      return;
+    }
+    wifiurl(buf, sizeof(buf), true, req, req->_arg1);
+    if (!http.begin(wifi->_secureclient, buf)) {
+      wifidone(req, WIFI_REQ_FAILED, "Failed to begin request");
+      return;
+    }
+  }
+  else {
+    wifiurl(buf, sizeof(buf), false, req, req->_arg1);
+    if (!http.begin(buf)) {
+      wifidone(req, WIFI_REQ_FAILED, "Failed to begin request");
+      return;
+    }
+  }
+  
+  http.addHeader("Cookie", wifi->_cookie);   
+  
+  int code = http.GET();
+  if (code <= 0) {
+    Serial.print("HTTPClient: ");
+    Serial.println(code);
+    wifidone(req, WIFI_REQ_FAILED, "HTTP failed");
+    return;
+  }
+  
+  if (code != HTTP_CODE_OK && code != 302) {
+    wifihttperror(req, code);
+    return;
+  }
+  
+  // read the body a bit at a time and stop as soon as we have the field.
+  LogoJsonField json(req->_arg2, req->_result, sizeof(req->_result));
+  short result = JSON_MORE;
+  WiFiClient *stream = http.getStreamPtr();
+  int left = http.getSize(); // -1 if the server didn't say
+  char chunk[WIFI_READ_LEN];
+  unsigned long start = millis();
+  while (result == JSON_MORE && (left > 0 || left == -1) && http.connected()) {
+    int avail = stream->available();
+    if (!avail) {
+      if (millis() - start > 5000) {
+        break;
+      }
+      delay(1);
+      continue;
+    }
+    int n = stream->readBytes(chunk, avail < (int)sizeof(chunk) ? avail : sizeof(chunk));
+    result = json.feed(chunk, n);
+    if (left > 0) {
+      left -= n;
+    }
+    start = millis();
+  }
+  http.end();
+  if (result == JSON_MORE) {
+    result = json.finish();
+  }
+  wififield(req, result, json.valuelen());
 
-  strcpy(gBuff, "http://");
-  int len = strlen(gBuff);
-  host.ncpy(gBuff + len, sizeof(gBuff) - len);
-  if (port != 80) {
-    strcat(gBuff, ":");
-    int len = strlen(gBuff);
-    snprintf(gBuff + len, sizeof(gBuff) - len, "%d", port);
+}
+
+static void wifiperformlogintest(LogoWifi *wifi, LogoWifiRequest *req) {
+
+  char buf[256]; // a generic buffer
+
+  if (req->_port == 443 || req->_port == 8443) {
+    wifidone(req, WIFI_REQ_FAILED, "Test login is not secure.");
+    return;
   }
-  strcat(gBuff, "/login/?username=");
-  len = strlen(gBuff);
-  username.ncpy(gBuff + len, sizeof(gBuff) - len);
   
-  Serial.println(gBuff);
+  HTTPClient http;
+
+  wifiurl(buf, sizeof(buf), false, req, "/login/?username=");
+  strncat(buf, req->_arg1, sizeof(buf) - strlen(buf) - 1);
+  
+  Serial.println(buf);
   
-  if (!http.begin(gBuff)) {
-    logo.throwException("Failed to begin request");
+  if (!http.begin(buf)) {
+    wifidone(req, WIFI_REQ_FAILED, "Failed to begin request");
     return;
   }
   
@@ -1023,77 +1244,45 @@ void LogoWords::wifilogintest(Logo &logo) {
   if (code <= 0) {
     Serial.print("HTTPClient: ");
     Serial.println(code);
-    logo.throwException("HTTP failed");
+    wifidone(req, WIFI_REQ_FAILED, "HTTP failed");
     return;
   }
   
   // should be a redrect.
   if (code != 302) {
-    strcpy(gBuff, "HTTP Error ");
-    int len = strlen(gBuff);
-    snprintf(gBuff + len, sizeof(gBuff) - len, "%d", code);
-    logo.throwException(gBuff);
+    wifihttperror(req, code);
     return;
   }
   
   // really just want the cookie from the header
   if (!http.hasHeader("Set-Cookie")) {
-    logo.throwException("Cookie missing");
+    wifidone(req, WIFI_REQ_FAILED, "Cookie missing");
     return;
   }
 
-  gCookie = http.header("Set-Cookie");
-
-  LogoSimpleString str(gCookie.c_str());
-  logo.pushstring(&str);
-#else
-  logo.throwException("Wifi not supported");
-#endif
-#else
-  LogoSimpleString str("cookie");
-  logo.pushstring(&str);
-#endif
+  wifi->_cookie = http.header("Set-Cookie");
+  wifidone(req, WIFI_REQ_DONE, wifi->_cookie.c_str());
   
 }
 
-void LogoWords::wifilogin(Logo &logo) {
+static void wifiperformlogin(LogoWifi *wifi, LogoWifiRequest *req) {
 
-  LogoStringResult password;
-  logo.popstring(&password);
-  
-  LogoStringResult username;
-  logo.popstring(&username);
-  
-  int port = logo.popint();
-  
-  LogoStringResult host;
-  logo.popstring(&host);
-  
-#ifdef ARDUINO
-#if defined(ESP32) && defined(USE_WIFI)
+  char buf[256]; // a generic buffer
 
-  host.ncpy(gBuff, sizeof(gBuff));
-  
-  if (WiFi.status() != WL_CONNECTED) {
-    logo.throwException("Wifi not connected");
-    return;
-  }
-  
   HTTPClient http;
 
-  if (gSecureClient.connect(gBuff, port) < 0) {
-    gSecureClient.lastError(gBuff, sizeof(gBuff));
-    logo.throwException(gBuff);
+  if (wifi->_secureclient.connect(req->_host, req->_port) < 0) {
+    wifi->_secureclient.lastError(buf, sizeof(buf));
+    wifidone(req, WIFI_REQ_FAILED, buf);
     return;
   }
 
-  strcpy(gBuff, "https://");
-  int len = strlen(gBuff);
-  host.ncpy(gBuff + len, sizeof(gBuff) - len);
-  strcat(gBuff, "/login");
+  strcpy(buf, "https://");
+  strncat(buf, req->_host, sizeof(buf) - strlen(buf) - 1);
+  strcat(buf, "/login");
 
-  if (!http.begin(gSecureClient, gBuff)) {
-    logo.throwException("Failed to begin request");
+  if (!http.begin(wifi->_secureclient, buf)) {
+    wifidone(req, WIFI_REQ_FAILED, "Failed to begin request");
     return;
   }
 
@@ -1102,52 +1291,263 @@ void LogoWords::wifilogin(Logo &logo) {
   
   http.addHeader("Content-Type", "application/json");   
 
-  strcpy(gBuff, "{ \"name\": \"");
-  len = strlen(gBuff);
-  username.ncpy(gBuff + len, sizeof(gBuff) - len);
-  strcat(gBuff, "\", \"password\": \"");
-  len = strlen(gBuff);
-  password.ncpy(gBuff + len, sizeof(gBuff) - len);
-  strcat(gBuff, "\", \"insecure\": false }");  
+  snprintf(buf, sizeof(buf), "{ \"name\": \"%s\", \"password\": \"%s\", \"insecure\": false }", req->_arg1, req->_arg2);
   
-  int code = http.POST((uint8_t *)gBuff, strlen(gBuff));
+  int code = http.POST((uint8_t *)buf, strlen(buf));
   if (code <= 0) {
     Serial.print("HTTPClient: ");
     Serial.println(code);
-    logo.throwException("HTTP failed");
+    wifidone(req, WIFI_REQ_FAILED, "HTTP failed");
     return;
   }
   
-  // should be a redrect.
   if (code != 200) {
-    strcpy(gBuff, "HTTP Error ");
-    int len = strlen(gBuff);
-    snprintf(gBuff + len, sizeof(gBuff) - len, "%d", code);
-    logo.throwException(gBuff);
+    wifihttperror(req, code);
     return;
   }
   
   // really just want the cookie from the header
   if (!http.hasHeader("Set-Cookie")) {
-    logo.throwException("Cookie missing");
+    wifidone(req, WIFI_REQ_FAILED, "Cookie missing");
     return;
   }
 
-  gCookie = http.header("Set-Cookie");
+  wifi->_cookie = http.header("Set-Cookie");
+  wifidone(req, WIFI_REQ_DONE, wifi->_cookie.c_str());
   
-  LogoSimpleString str(gCookie.c_str());
-  logo.pushstring(&str);
+}
+
+void LogoWifi::perform(LogoWifiRequest *req) {
+
+  if (req->_kind != WIFI_REQ_CONNECT && WiFi.status() != WL_CONNECTED) {
+    wifidone(req, WIFI_REQ_FAILED, "Wifi not connected");
+    return;
+  }
+  switch (req->_kind) {
+    case WIFI_REQ_CONNECT:
+      wifiperformconnect(this, req);
+      break;
+    case WIFI_REQ_GET:
+      wifiperformget(this, req);
+      break;
+    case WIFI_REQ_LOGINTEST:
+      wifiperformlogintest(this, req);
+      break;
+    case WIFI_REQ_LOGIN:
+      wifiperformlogin(this, req);
+      break;
+  }
+  
+}
+
+#else
+
+// just like above but with the stand in.
+void LogoWifi::perform(LogoWifiRequest *req) {
+
+  switch (req->_kind) {
+  
+    case WIFI_REQ_CONNECT:
+      if (_http->connect(req->_arg1, req->_arg2, req->_result, sizeof(req->_result))) {
+        req->_result[sizeof(req->_result) - 1] = 0;
+        req->_resultlen = strlen(req->_result);
+        req->_state = WIFI_REQ_DONE;
+      }
+      else {
+        wifidone(req, WIFI_REQ_FAILED, "Connect failed");
+      }
+      break;
+      
+    case WIFI_REQ_GET:
+      {
+        int code = _http->get(req->_host, req->_port, req->_arg1);
+        if (code != 200 && code != 302) {
+          wifihttperror(req, code);
+          break;
+        }
+        LogoJsonField json(req->_arg2, req->_result, sizeof(req->_result));
+        short result = JSON_MORE;
+        char chunk[WIFI_READ_LEN];
+        while (result == JSON_MORE) {
+          int n = _http->read(chunk, sizeof(chunk));
+          if (n <= 0) {
+            break;
+          }
+          result = json.feed(chunk, n);
+        }
+        if (result == JSON_MORE) {
+          result = json.finish();
+        }
+        wififield(req, result, json.valuelen());
+      }
+      break;
+      
+    case WIFI_REQ_LOGINTEST:
+    case WIFI_REQ_LOGIN:
+      {
+        int code = _http->login(req->_host, req->_port, req->_arg1, req->_arg2, _cookie, sizeof(_cookie));
+        if (code != 200 && code != 302) {
+          wifihttperror(req, code);
+          break;
+        }
+        wifidone(req, WIFI_REQ_DONE, _cookie);
+      }
+      break;
+  }
+  
+}
+
+#endif // ARDUINO
+
+#endif // USE_WIFI_ASYNC
+
+void LogoWords::wifisockets(LogoBase &logo) {
+
+  LogoStringResult openmsg;
+  logo.popstring(&openmsg);
+  
+  int port = logo.popint();
+  
+  LogoStringResult host;
+  logo.popstring(&host);
+  
+#ifdef ARDUINO
+#if defined(ESP32) && defined(USE_WIFI)
+
+  char buf[256]; // a generic buffer
+
+  host.ncpy(buf, sizeof(buf));
+  openmsg.ncpy(logo._wifi._msg, sizeof(logo._wifi._msg));
+
+	if (port == 443 || port == 8443) {
+    logo._wifi._wsclient.beginSSL(buf, port);
+	}
+	else {
+    logo._wifi._wsclient.begin(buf, port);
+	}
+
+	// event handler, for this logo.
+	LogoBase *l = &logo;
+	logo._wifi._wsclient.onEvent([l](socketIOmessageType_t type, uint8_t *payload, size_t length) {
+	  l->_wifi.event(l, type, payload, length);
+	});
+
+  strcpy(buf, "Cookie: ");
+  strcat(buf, logo._wifi._cookie.c_str());
+  logo._wifi._wsclient.setExtraHeaders(buf);
+
+	// try ever 5000 again if connection has failed
+  logo._wifi._wsclient.setReconnectInterval(5000);
 #else
   logo.throwException("Wifi not supported");
 #endif
 #else
-  LogoSimpleString str("cookie");
-  logo.pushstring(&str);
+  logo.out() << "Wifi Sockets " << endl;
+#endif // ARDUINO
+
+}
+
+void LogoWords::vopsopenmsg(LogoBase &logo) {
+
+  LogoStringResult docid;
+  logo.popstring(&docid);
+  
+  LogoStringResult userid;
+  logo.popstring(&userid);
+  
+#ifdef ARDUINO
+#if defined(ESP32) && defined(USE_WIFI)
+
+  char buf[256]; // a generic buffer
+  strcpy(buf, "[ \"openDocuments\", { \"docs\": [ { \"id\": \"");
+  int len = strlen(buf);
+  docid.ncpy(buf + len, sizeof(buf) - len);
+  strcat(buf, "\", \"type\": \"stream\" } ], \"userid\": \"");
+  len = strlen(buf);
+  userid.ncpy(buf + len, sizeof(buf) - len);
+  strcat(buf, "\" } ]");
+
+  LogoSimpleString s(buf);
+  logo.pushstring(&s);
+#else
+  logo.throwException("Wifi not supported");
+#endif
+#else
+  LogoSimpleString s("Make open message");
+  logo.pushstring(&s);
 #endif
   
 }
 
-void LogoWords::btstart(Logo &logo) {
+void LogoWords::wifilogintest(LogoBase &logo) {
+
+  LogoStringResult username;
+  logo.popstring(&username);
+  
+  int port = logo.popint();
+  
+  LogoStringResult host;
+  logo.popstring(&host);
+  
+#ifdef USE_WIFI_ASYNC
+#ifndef ARDUINO
+  if (!logo._wifi._http) {
+    LogoSimpleString str("cookie");
+    logo.pushstring(&str);
+    return;
+  }
+#endif
+  LogoWifiRequest *req = wifirequest(logo, WIFI_REQ_LOGINTEST);
+  if (!req) {
+    return;
+  }
+  host.ncpy(req->_host, sizeof(req->_host));
+  req->_port = port;
+  username.ncpy(req->_arg1, sizeof(req->_arg1));
+  logo._wifi.start(thistask(logo));
+#else
+  logo.throwException("Wifi not supported");
+#endif
+  
+}
+
+void LogoWords::wifilogin(LogoBase &logo) {
+
+  LogoStringResult password;
+  logo.popstring(&password);
+  
+  LogoStringResult username;
+  logo.popstring(&username);
+  
+  int port = logo.popint();
+  
+  LogoStringResult host;
+  logo.popstring(&host);
+  
+#ifdef USE_WIFI_ASYNC
+#ifndef ARDUINO
+  if (!logo._wifi._http) {
+    LogoSimpleString str("cookie");
+    logo.pushstring(&str);
+    return;
+  }
+#endif
+  LogoWifiRequest *req = wifirequest(logo, WIFI_REQ_LOGIN);
+  if (!req) {
+    return;
+  }
+  host.ncpy(req->_host, sizeof(req->_host));
+  req->_port = port;
+  username.ncpy(req->_arg1, sizeof(req->_arg1));
+  password.ncpy(req->_arg2, sizeof(req->_arg2));
+  logo._wifi.start(thistask(logo));
+#else
+  logo.throwException("Wifi not supported");
+#endif
+  
+}
+
+void LogoWords::btstart(LogoBase &logo) {
 
   LogoStringResult serviceuid;
   logo.popstring(&serviceuid);
@@ -1159,11 +1559,12 @@ void LogoWords::btstart(Logo &logo) {
 #if defined(ESP32) && defined(USE_BT)
 
   char sname[32];
+  char suid[64];
 
   name.ncpy(sname, sizeof(sname));
-  serviceuid.ncpy(gBuff, sizeof(gBuff));
+  serviceuid.ncpy(suid, sizeof(suid));
   
-  logo._ble.start(&logo, logo._sketch, sname, gBuff);
+  logo._ble.start(&logo, logo._sketch, sname, suid);
   
   Serial.print("BLE: Waiting for a client connection: ");
   Serial.println(sname);
@@ -1177,19 +1578,19 @@ void LogoWords::btstart(Logo &logo) {
   
 }
 
-void LogoWords::throwWord(Logo &logo) {
+void LogoWords::throwWord(LogoBase &logo) {
 
   logo.doThrow();
   
 }
 
-void LogoWords::intWord(Logo &logo) {
+void LogoWords::intWord(LogoBase &logo) {
 
   logo.pushint((int)logo.popdouble());
   
 }
 
-void LogoWords::midinoteon(Logo &logo) {
+void LogoWords::midinoteon(LogoBase &logo) {
 
   int velocity = logo.popint();
   int pitch = logo.popint();
@@ -1215,7 +1616,7 @@ void LogoWords::midinoteon(Logo &logo) {
 
 }
 
-void LogoWords::midinoteoff(Logo &logo) {
+void LogoWords::midinoteoff(LogoBase &logo) {
 
   int pitch = logo.popint();
   int channel = logo.popint();
@@ -1240,3 +1641,97 @@ void LogoWords::midinoteoff(Logo &logo) {
 
 }
 
+void LogoWords::profile(LogoBase &logo) {
+
+#ifdef USE_PROFILE
+  // print what we have so far and start again.
+  if (logo.profiling()) {
+    logo.printprofile();
+  }
+  logo.startprofile();
+#else
+  logo.throwException("Profile not supported");
+#endif
+
+}
+
+void LogoWords::trace(LogoBase &logo) {
+
+#ifdef USE_TRACE
+  // dump what we have so far and start again.
+  if (logo.tracing()) {
+    logo.printtrace();
+  }
+  logo.starttrace();
+#else
+  logo.throwException("Trace not supported");
+#endif
+
+}
+
+void LogoWords::launch(LogoBase &logo) {
+
+#ifdef USE_TASKS
+  // our code looks like:
+	//  builtin LAUNCH		(pc)
+	//  WORD
+	//
+  short arity = 0;
+  short jump = logo.codetoword(1, &arity);
+  if (jump < 0 || jump == NO_JUMP) {
+    logo.fail(LG_NOT_CALLABLE);
+    return;
+  }
+  if (arity) {
+    logo.fail(LG_ARITY_NOT_IMPL);
+    return;
+  }
+  if (!logo.launch(jump)) {
+    logo.fail(LG_TOO_MANY_TASKS);
+    return;
+  }
+  
+  // the word runs in the task, not here.
+  logo.jump(2);
+#else
+  logo.throwException("Launch not supported");
+#endif
+
+}
+
+void LogoWords::when(LogoBase &logo) {
+
+#ifdef USE_EVENTS
+  // our code looks like:
+	//  builtin WHEN		(pc)
+	//  STRING (the event)
+	//  WORD
+	//
+  if (!logo.codeisstring(1)) {
+    logo.fail(LG_NOT_STRING);
+    return;
+  }
+  tStrPool name, len;
+  logo.codetostring(1, &name, &len);
+  short arity = 0;
+  short jump = logo.codetoword(2, &arity);
+  if (jump < 0 || jump == NO_JUMP) {
+    logo.fail(LG_NOT_CALLABLE);
+    return;
+  }
+  if (arity) {
+    logo.fail(LG_ARITY_NOT_IMPL);
+    return;
+  }
+  if (!logo.when(name, len, jump)) {
+    logo.fail(LG_TOO_MANY_HANDLERS);
+    return;
+  }
+  
+  // the word runs when the event comes in, not here.
+  logo.jump(3);
+#else
+  logo.throwException("When not supported");
+#endif
+
+}
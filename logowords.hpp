@@ -16,7 +16,7 @@
 #ifndef H_logowords
 #define H_logowords
 
-class Logo;
+class LogoBase;
 class LogoSimpleString;
 class LogoStringResult;
 
@@ -24,60 +24,65 @@ class LogoWords {
 
 public:
 
-  static void err(Logo &logo);
-  static void ifelse(Logo &logo);
-  static void ifWord(Logo &logo);
-  static void repeat(Logo &logo);
-  static void forever(Logo &logo);
-  static void make(Logo &logo);
-  static void wait(Logo &logo);
-  static void subtract(Logo &logo);
-  static void add(Logo &logo);
-  static void divide(Logo &logo);
-  static void multiply(Logo &logo);
-  static void eq(Logo &logo);
-  static void neq(Logo &logo);
-  static void gt(Logo &logo);
-  static void gte(Logo &logo);
-  static void lt(Logo &logo);
-  static void lte(Logo &logo);
-  static void notWord(Logo &logo);
-  static void dumpvars(Logo &logo);
-  static void print(Logo &logo);
-  static void dread(Logo &logo);
-  static void dhigh(Logo &logo);
-  static void dlow(Logo &logo);
-  static void pinout(Logo &logo);
-  static void pinin(Logo &logo);
-  static void pininup(Logo &logo);
-  static void aout(Logo &logo);
-  static void thing(Logo &logo);
-  static void output(Logo &logo);
-  static void wordWord(Logo &logo);
-  static void first(Logo &logo);
-  static void type(Logo &logo);
-  static void machineinfo(Logo &logo);
-  static void pinrgb(Logo &logo);
-  static void rgbout(Logo &logo);
-  static void wifiscan(Logo &logo);
-  static void wifiget(Logo &logo);
-  static void wifisockets(Logo &logo);
-  static void vopsopenmsg(Logo &logo);
-  static void wifilogintest(Logo &logo);
-  static void wifilogin(Logo &logo);
-  static void wifistation(Logo &logo);
-  static void wificonnect(Logo &logo);
-  static void btstart(Logo &logo);
-  static void throwWord(Logo &logo);
-  static void intWord(Logo &logo);
-  static void midinoteon(Logo &logo);
-  static void midinoteoff(Logo &logo);
+  static void err(LogoBase &logo);
+  static void ifelse(LogoBase &logo);
+  static void ifWord(LogoBase &logo);
+  static void repeat(LogoBase &logo);
+  static void forever(LogoBase &logo);
+  static void make(LogoBase &logo);
+  static void wait(LogoBase &logo);
+  static void subtract(LogoBase &logo);
+  static void add(LogoBase &logo);
+  static void divide(LogoBase &logo);
+  static void multiply(LogoBase &logo);
+  static void eq(LogoBase &logo);
+  static void neq(LogoBase &logo);
+  static void gt(LogoBase &logo);
+  static void gte(LogoBase &logo);
+  static void lt(LogoBase &logo);
+  static void lte(LogoBase &logo);
+  static void notWord(LogoBase &logo);
+  static void dumpvars(LogoBase &logo);
+  static void print(LogoBase &logo);
+  static void dread(LogoBase &logo);
+  static void dhigh(LogoBase &logo);
+  static void dlow(LogoBase &logo);
+  static void pinout(LogoBase &logo);
+  static void pinin(LogoBase &logo);
+  static void pininup(LogoBase &logo);
+  static void aout(LogoBase &logo);
+  static void thing(LogoBase &logo);
+  static void output(LogoBase &logo);
+  static void wordWord(LogoBase &logo);
+  static void first(LogoBase &logo);
+  static void type(LogoBase &logo);
+  static void machineinfo(LogoBase &logo);
+  static void pinrgb(LogoBase &logo);
+  static void rgbout(LogoBase &logo);
+  static void wifiscan(LogoBase &logo);
+  static void wifiget(LogoBase &logo);
+  static void wifisockets(LogoBase &logo);
+  static void vopsopenmsg(LogoBase &logo);
+  static void wifilogintest(LogoBase &logo);
+  static void wifilogin(LogoBase &logo);
+  static void wifistation(LogoBase &logo);
+  static void wificonnect(LogoBase &logo);
+  static void btstart(LogoBase &logo);
+  static void throwWord(LogoBase &logo);
+  static void intWord(LogoBase &logo);
+  static void midinoteon(LogoBase &logo);
+  static void midinoteoff(LogoBase &logo);
+  static void profile(LogoBase &logo);
+  static void trace(LogoBase &logo);
+  static void launch(LogoBase &logo);
+  static void when(LogoBase &logo);
 
   static bool extractEventName(LogoSimpleString *s, char *name, int len);
 
 private:
 
-  static bool pushliterals(Logo &logo, short rel);
+  static bool pushliterals(LogoBase &logo, short rel);
+  static void printresult(LogoBase &logo, LogoStringResult *result);
 
 };
 
@@ -24,6 +24,7 @@
 #include <iostream>
 #include <vector>
 #include <strstream>
+#include <thread>
 
 using namespace std;
 
@@ -382,6 +383,56 @@ BOOST_AUTO_TEST_CASE( sizes )
   
 }
 
+struct TinyCapacity: public LogoCapacity {
+  static const short code = 12;
+  static const short maxcode = 12;
+  static const short startjcode = 6;
+  static const short stack = 8;
+  static const short words = 2;
+};
+
+struct BigCapacity: public LogoCapacity {
+  static const short code = 200;
+  static const short maxcode = 200;
+  static const short startjcode = 100;
+  static const short stack = 32;
+  static const short words = 8;
+};
+
+BOOST_AUTO_TEST_CASE( capacities )
+{
+  cout << "=== capacities ===" << endl;
+  
+  // two different sized ones side by side.
+  LogoT<TinyCapacity> tiny;
+  LogoCompilerT<TinyCapacity> tinycompiler(&tiny);
+  LogoT<BigCapacity> big;
+  LogoCompilerT<BigCapacity> bigcompiler(&big);
+  
+  BOOST_CHECK_EQUAL(tiny.maxcode(), 12);
+  BOOST_CHECK_EQUAL(tiny.startjcode(), 6);
+  BOOST_CHECK_EQUAL(big.maxstack(), 32);
+  BOOST_CHECK(sizeof(tiny) < sizeof(big));
+  
+  bigcompiler.compile("TO SQ :A; :A * :A; END; SQ 1 SQ 2 SQ 3 SQ 4");
+  BOOST_CHECK_EQUAL(big.geterr(), 0);
+  BOOST_CHECK_EQUAL(big.run(), 0);
+  BOOST_CHECK_EQUAL(big.popint(), 16);
+  
+  // a word too big for the tiny one.
+  tinycompiler.compile("TO BIG; 1 2 3 4 5 6 7 8; END;");
+  BOOST_CHECK_EQUAL(tiny.geterr(), LG_OUT_OF_CODE);
+  
+  // but something small still runs.
+  tinycompiler.reset();
+  tiny.reset();
+  tinycompiler.compile("TO SQ :A; :A * :A; END; SQ 3");
+  BOOST_CHECK_EQUAL(tiny.geterr(), 0);
+  BOOST_CHECK_EQUAL(tiny.run(), 0);
+  BOOST_CHECK_EQUAL(tiny.popint(), 9);
+  
+}
+
 BOOST_AUTO_TEST_CASE( arguments )
 {
   cout << "=== arguments ===" << endl;
@@ -805,3 +856,278 @@ BOOST_AUTO_TEST_CASE( fullStringsNumber )
 }
 
 
+
+BOOST_AUTO_TEST_CASE( tailCall )
+{
+  cout << "=== tailCall ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("TO ON; print \"ON; END");
+  compiler.compile("TO OFF; print \"OFF; END");
+  compiler.compile("TO TEST1; ON OFF; END;");
+  compiler.compile("TO TEST2; TEST1; END;");
+  compiler.compile("TEST2; ON;");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  stringstream s;
+  logo.setout(&s);
+
+  DEBUG_STEP_DUMP(10, false);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(s.str(), "=== ON\n=== OFF\n=== ON\n");
+  BOOST_CHECK(logo.stackempty());
+  
+}
+
+BOOST_AUTO_TEST_CASE( tailRecursion )
+{
+  cout << "=== tailRecursion ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+
+  // much deeper than the stack.
+  compiler.compile("TO DOWN; make \"N :N - 1; if :N > 0 DOWN; END;");
+  compiler.compile("make \"N 100");
+  compiler.compile("DOWN");
+  compiler.compile(":N");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  DEBUG_STEP_DUMP(20, false);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(logo.popint(), 0);
+  BOOST_CHECK(logo.stackempty());
+  
+}
+
+BOOST_AUTO_TEST_CASE( tailCallForever )
+{
+  cout << "=== tailCallForever ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("TO ON; print \"ON; END");
+  compiler.compile("TO OFF; print \"OFF; END");
+  compiler.compile("TO DOIT; ON OFF; END");
+  compiler.compile("REPEAT 3 DOIT");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  stringstream s;
+  logo.setout(&s);
+
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(s.str(), "=== ON\n=== OFF\n=== ON\n=== OFF\n=== ON\n=== OFF\n");
+  
+}
+
+BOOST_AUTO_TEST_CASE( profile )
+{
+  cout << "=== profile ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("TO ON; print \"ON; END");
+  compiler.compile("TO DOIT; ON ON; END");
+  compiler.compile("REPEAT 3 DOIT");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  stringstream s;
+  logo.setout(&s);
+
+  logo.startprofile();
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  logo.stopprofile();
+  
+  stringstream p;
+  logo.setout(&p);
+  logo.printprofile(&compiler);
+  string profile = p.str();
+  BOOST_CHECK(profile.find("profile steps ") == 0);
+  BOOST_CHECK(profile.find("  DOIT steps ") != string::npos);
+  BOOST_CHECK(profile.find("  PRINT calls 6 ") != string::npos);
+  BOOST_CHECK(profile.find("  REPEAT calls 1 ") != string::npos);
+  BOOST_CHECK(profile.find("  DOIT -> ON 6\n") != string::npos);
+  
+}
+
+BOOST_AUTO_TEST_CASE( profileWord )
+{
+  cout << "=== profileWord ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("TO ON; print \"ON; END");
+  compiler.compile("PROFILE ON ON PROFILE");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  stringstream s;
+  logo.setout(&s);
+
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK(logo.profiling());
+  string out = s.str();
+  BOOST_CHECK(out.find("=== ON\n=== ON\nprofile steps ") == 0);
+  BOOST_CHECK(out.find("  PRINT calls 2 ") != string::npos);
+  BOOST_CHECK(out.find("  (top) -> (") != string::npos);
+  
+}
+
+BOOST_AUTO_TEST_CASE( trace )
+{
+  cout << "=== trace ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("TO DOWN; make \"N :N - 1; if :N > 0 DOWN; END;");
+  compiler.compile("make \"N 100");
+  compiler.compile("DOWN");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  logo.starttrace();
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  logo.stoptrace();
+  
+  // it wrapped around so we only have the last steps.
+  BOOST_CHECK_EQUAL(logo.tracecount(), TRACE_SIZE);
+  unsigned char buf[TRACE_SIZE * TRACE_ENTRY_LEN];
+  BOOST_CHECK_EQUAL(logo.tracedump(buf, sizeof(buf)), sizeof(buf));
+  
+  // the last step is the HALT at the end of the top level.
+  unsigned char *last = buf + (TRACE_SIZE - 1) * TRACE_ENTRY_LEN;
+  BOOST_CHECK_EQUAL(last[0] | (last[1] << 8), logo.pc());
+  BOOST_CHECK_EQUAL(last[2], OPTYPE_HALT);
+  BOOST_CHECK_EQUAL(last[3], 0);
+
+  // and the steps are in order.
+  for (short i=1; i<TRACE_SIZE; i++) {
+    unsigned char *e = buf + i * TRACE_ENTRY_LEN;
+    unsigned char *p = e - TRACE_ENTRY_LEN;
+    unsigned long us = e[4] | (e[5] << 8) | (e[6] << 16) | ((unsigned long)e[7] << 24);
+    unsigned long pus = p[4] | (p[5] << 8) | (p[6] << 16) | ((unsigned long)p[7] << 24);
+    BOOST_CHECK(((us - pus) & 0xffffffff) < 0x80000000);
+  }
+  
+  // only whole entries.
+  BOOST_CHECK_EQUAL(logo.tracedump(buf, TRACE_ENTRY_LEN + 3), TRACE_ENTRY_LEN);
+  
+}
+
+BOOST_AUTO_TEST_CASE( traceWord )
+{
+  cout << "=== traceWord ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("TRACE print 1 TRACE");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  stringstream s;
+  logo.setout(&s);
+
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK(logo.tracing());
+  
+  // print 1, then the second TRACE. The times are real so only check the
+  // pc, optype and tos.
+  string line;
+  getline(s, line);
+  BOOST_CHECK_EQUAL(line, "=== 1");
+  getline(s, line);
+  BOOST_CHECK_EQUAL(line, "trace 4");
+  const char *steps[] = { "01000300", "02000701", "03000302", "03000300" };
+  for (int i=0; i<4; i++) {
+    getline(s, line);
+    BOOST_CHECK_EQUAL(line.size(), TRACE_ENTRY_LEN * 2);
+    BOOST_CHECK_EQUAL(line.substr(0, 8), steps[i]);
+  }
+  getline(s, line);
+  BOOST_CHECK_EQUAL(line, "end");
+  
+}
+
+static void runcount(int n, string *out) {
+
+  Logo logo;
+  LogoCompiler compiler(&logo);
+  stringstream s;
+  logo.setout(&s);
+  
+  compiler.compile("TO COUNT; make \"N :N + 1; print :N; END;");
+  s << "START " << n << endl;
+  compiler.compile("make \"N 0");
+  compiler.compile("repeat 5 COUNT");
+  logo.run();
+  *out = s.str();
+  
+}
+
+BOOST_AUTO_TEST_CASE( threads )
+{
+  cout << "=== threads ===" << endl;
+  
+  // each Logo has everything it needs so they can all run at once.
+  vector<string> outs(4);
+  vector<thread> threads;
+  for (int i=0; i<4; i++) {
+    threads.push_back(thread(runcount, i, &outs[i]));
+  }
+  for (auto &t: threads) {
+    t.join();
+  }
+  for (int i=0; i<4; i++) {
+    stringstream s;
+    s << "START " << i << "\n=== 1\n=== 2\n=== 3\n=== 4\n=== 5\n";
+    BOOST_CHECK_EQUAL(outs[i], s.str());
+  }
+  
+}
+
+BOOST_AUTO_TEST_CASE( eventQueue )
+{
+  cout << "=== eventQueue ===" << endl;
+  
+  LogoEventQueue *queue = new LogoEventQueue();
+  const int count = 100000;
+  
+  // one thread putting them in as fast as it can and us taking them out.
+  thread producer([queue]() {
+    for (int i=0; i<count; i++) {
+      string data = to_string(i);
+      while (!queue->push("n", 1, data.c_str(), data.size())) {
+      }
+    }
+  });
+  
+  int next = 0;
+  bool inorder = true;
+  while (next < count) {
+    LogoEvent *event = queue->front();
+    if (!event) {
+      continue;
+    }
+    if (string(event->_data, event->_datalen) != to_string(next)) {
+      inorder = false;
+    }
+    queue->pop();
+    next++;
+  }
+  producer.join();
+  BOOST_CHECK(inorder);
+  BOOST_CHECK(queue->empty());
+  delete queue;
+  
+}
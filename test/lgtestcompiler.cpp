@@ -22,6 +22,7 @@
 
 #include <iostream>
 #include <vector>
+#include <set>
 #include <strstream>
 #include <string>
 
@@ -359,3 +360,348 @@ BOOST_AUTO_TEST_CASE( replacedirectivesAutoAssign )
   BOOST_CHECK_EQUAL(line, "1 2");  
   
 }
+
+BOOST_AUTO_TEST_CASE( feedChunks )
+{
+  cout << "=== feedChunks ===" << endl;
+  
+  const char *program = 
+    "# a comment\n"
+    "to SAY :A :B\n"
+    "  print :A print :B\n"
+    "end\n"
+    "to GREET; print \"hello\"; end\n"
+    "  SAY \"x 3\n"
+    "GREET";
+  short len = strlen(program);
+  
+  // every size of piece gives the same result as all at once.
+  for (short chunk=1; chunk<=len; chunk++) {
+    Logo logo;
+    LogoCompiler compiler(&logo);
+    for (short i=0; i<len; i+=chunk) {
+      compiler.feed(program + i, min(chunk, (short)(len - i)));
+    }
+    compiler.flush();
+    BOOST_CHECK_EQUAL(logo.geterr(), 0);
+
+    stringstream s;
+    logo.setout(&s);
+    BOOST_CHECK_EQUAL(logo.run(), 0);
+    BOOST_CHECK_EQUAL(s.str(), "=== 3\n=== x\n=== hello\n");
+  }
+  
+}
+
+BOOST_AUTO_TEST_CASE( feedTokenTooLong )
+{
+  cout << "=== feedTokenTooLong ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+  
+  string token(TOKEN_LEN + 1, 'A');
+  compiler.feed(token.c_str(), token.length());
+  compiler.flush();
+  BOOST_CHECK_EQUAL(logo.geterr(), LG_TOKEN_TOO_LONG);
+
+}
+
+static const char *imageprogram = 
+  "to SAY :A\n"
+  "  print :A\n"
+  "end\n"
+  "to NOTHING\n"
+  "end\n"
+  "to GREET\n"
+  "  NOTHING SAY \"hello SAY [a b] SAY 2.5\n"
+  "end\n"
+  "GREET\n";
+
+BOOST_AUTO_TEST_CASE( image )
+{
+  cout << "=== image ===" << endl;
+  
+  string image;
+  {
+    Logo logo;
+    LogoCompiler compiler(&logo);
+    compiler.setconstlists(false);
+    compiler.compile(imageprogram);
+    BOOST_CHECK_EQUAL(logo.geterr(), 0);
+    compiler.writeimage(&image);
+  }
+  
+  // any size of piece.
+  for (short chunk=1; chunk<=(short)image.size(); chunk+=7) {
+    Logo logo;
+    LogoCompiler compiler(&logo);
+    
+    // this is all replaced.
+    compiler.compile("to OLD; print \"old; end; OLD");
+    
+    for (short i=0; i<(short)image.size(); i+=chunk) {
+      compiler.feedimage(image.c_str() + i, min(chunk, (short)(image.size() - i)));
+    }
+    BOOST_CHECK_EQUAL(logo.geterr(), 0);
+
+    stringstream s;
+    logo.setout(&s);
+    BOOST_CHECK_EQUAL(logo.run(), 0);
+    BOOST_CHECK_EQUAL(s.str(), "=== hello\n=== a b\n=== 2.500000\n");
+    
+    // and the words can still be used.
+    s.str("");
+    logo.resetcode();
+    compiler.compile("SAY \"again");
+    BOOST_CHECK_EQUAL(logo.geterr(), 0);
+    BOOST_CHECK_EQUAL(logo.run(), 0);
+    BOOST_CHECK_EQUAL(s.str(), "=== again\n");
+    BOOST_CHECK_EQUAL(compiler.callword("OLD"), LG_WORD_NOT_FOUND);
+  }
+  
+}
+
+BOOST_AUTO_TEST_CASE( imageBad )
+{
+  cout << "=== imageBad ===" << endl;
+  
+  string image;
+  {
+    Logo logo;
+    LogoCompiler compiler(&logo);
+    compiler.setconstlists(false);
+    compiler.compile(imageprogram);
+    compiler.writeimage(&image);
+  }
+  
+  {
+    // a byte got changed.
+    Logo logo;
+    LogoCompiler compiler(&logo);
+    string bad = image;
+    bad[20] ^= 1;
+    compiler.feedimage(bad.c_str(), bad.size());
+    BOOST_CHECK_EQUAL(logo.geterr(), LG_BAD_IMAGE);
+  }
+  
+  {
+    // not all of it came.
+    Logo logo;
+    LogoCompiler compiler(&logo);
+    compiler.feedimage(image.c_str(), image.size() - 10);
+    BOOST_CHECK_EQUAL(logo.geterr(), 0);
+    compiler.flush();
+    BOOST_CHECK_EQUAL(logo.geterr(), LG_BAD_IMAGE);
+    
+    // but the next one is fine.
+    compiler.feedimage(image.c_str(), image.size());
+    BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  }
+  
+  {
+    // not an image at all.
+    Logo logo;
+    LogoCompiler compiler(&logo);
+    const char *text = "to GREET\nprint \"hello\nend\n";
+    compiler.feedimage(text, strlen(text));
+    BOOST_CHECK_EQUAL(logo.geterr(), LG_BAD_IMAGE);
+  }
+  
+}
+
+BOOST_AUTO_TEST_CASE( stackDepth )
+{
+  cout << "=== stackDepth ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+  compiler.compile("to SQ :X; :X * :X; end;");
+  compiler.compile("to SUM :A :B; (SQ :A) + SQ :B; end;");
+  compiler.compile("to SHOW; print SUM 3 4; end;");
+  compiler.compile("to AGAIN; print 1; AGAIN; end;");
+  compiler.compile("to DOWN :N; if :N > 0 [ DOWN :N - 1 ]; end;");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  
+  short depths[5];
+  const char *words[] = { "SQ", "SUM", "SHOW", "AGAIN", "DOWN" };
+  for (short i=0; i<5; i++) {
+    depths[i] = 0;
+    for (short pc=START_JCODE; pc<logo._nextjcode; pc++) {
+      char name[LINE_LEN];
+      if (compiler.wordname(pc, name, sizeof(name)) && strcmp(name, words[i]) == 0) {
+        depths[i] = compiler.stackdepth(pc);
+        break;
+      }
+    }
+  }
+  
+  // each one needs at least what the words it calls do.
+  BOOST_CHECK(depths[0] > 0);
+  BOOST_CHECK(depths[1] > depths[0]);
+  BOOST_CHECK(depths[2] > depths[1]);
+  
+  // calling itself at the end reuses the frame but not from inside a list.
+  BOOST_CHECK(depths[3] > 0);
+  BOOST_CHECK_EQUAL(depths[4], -1);
+  
+  // and it's never less than it really uses.
+  stringstream s;
+  logo.setout(&s);
+  compiler.compile("SHOW");
+  short peak = 0;
+  while (logo.step() == 0) {
+    peak = max(peak, logo.stackdepth());
+  }
+  BOOST_CHECK_EQUAL(s.str(), "=== 25\n");
+  BOOST_CHECK(peak > 0);
+  BOOST_CHECK(peak <= depths[2]);
+  
+}
+
+BOOST_AUTO_TEST_CASE( stackReport )
+{
+  cout << "=== stackReport ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+  compiler.compile("to SQ :X; :X * :X; end;");
+  compiler.compile("to DOWN :N; if :N > 0 [ DOWN :N - 1 ]; end;");
+  compiler.compile("to GO; DOWN SQ 3; end;");
+  compiler.compile("print SQ 3");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  
+  stringstream s;
+  compiler.stackreport(s, "  ");
+  vector<string> lines;
+  string line;
+  while (getline(s, line)) {
+    lines.push_back(line);
+  }
+  BOOST_CHECK_EQUAL(lines.size(), 4);
+  if (lines.size() == 4) {
+    BOOST_CHECK(lines[0].find("  (top) ") == 0);
+    BOOST_CHECK(lines[1].find("  SQ ") == 0);
+    BOOST_CHECK_EQUAL(lines[2], "  DOWN recursive: DOWN -> DOWN");
+    BOOST_CHECK_EQUAL(lines[3], "  GO recursive: DOWN -> DOWN");
+  }
+  
+}
+
+BOOST_AUTO_TEST_CASE( deadWords )
+{
+  cout << "=== deadWords ===" << endl;
+  
+  const char *code = 
+    "to SQ :X; :X * :X; end;\n"
+    "to CUBE :X; :X * SQ :X; end;\n"
+    "to UNUSED; print \"never; end;\n"
+    "to SETUP; print SQ 2; end;\n"
+    "to GO; forever [ TICK ]; end;\n"
+    "to TICK; wait 10; end;\n"
+    "to STOP; print \"stopped; end;\n"
+    "GO\n";
+    
+  Logo logo;
+  LogoCompiler compiler(&logo);
+  compiler.setconstlists(false);
+  compiler.compile(code);
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  
+  // TICK is only named in the list before it's defined.
+  set<string> roots;
+  roots.insert("SETUP");
+  set<string> dead;
+  compiler.deadwords(roots, &dead);
+  BOOST_CHECK_EQUAL(dead.size(), 3);
+  BOOST_CHECK(dead.find("CUBE") != dead.end());
+  BOOST_CHECK(dead.find("UNUSED") != dead.end());
+  BOOST_CHECK(dead.find("STOP") != dead.end());
+  
+  // and a command keeps one.
+  roots.insert("STOP");
+  dead.clear();
+  compiler.deadwords(roots, &dead);
+  BOOST_CHECK_EQUAL(dead.size(), 2);
+  BOOST_CHECK(dead.find("STOP") == dead.end());
+  
+  // compiled again without them.
+  Logo logo2;
+  LogoCompiler compiler2(&logo2);
+  compiler2.setconstlists(false);
+  compiler2.leaveout(&dead);
+  compiler2.compile(code);
+  BOOST_CHECK_EQUAL(logo2.geterr(), 0);
+  BOOST_CHECK(logo2.codeused() < logo.codeused());
+  BOOST_CHECK(logo2.stringsused() < logo.stringsused());
+  char name[LINE_LEN];
+  short words = 0;
+  for (short pc=START_JCODE; pc<logo2._nextjcode; pc++) {
+    if (compiler2.wordname(pc, name, sizeof(name))) {
+      BOOST_CHECK(dead.find(name) == dead.end());
+      words++;
+    }
+  }
+  BOOST_CHECK_EQUAL(words, 5);
+  
+  // and it still runs.
+  stringstream s;
+  logo2.setout(&s);
+  logo2.resetcode();
+  compiler2.compile("SETUP");
+  BOOST_CHECK_EQUAL(logo2.run(), 0);
+  BOOST_CHECK_EQUAL(s.str(), "=== 4\n");
+  
+}
+
+BOOST_AUTO_TEST_CASE( measureConfig )
+{
+  cout << "=== measureConfig ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+  compiler.setconstlists(false);
+  compiler.compile("to LED; 13; end;");
+  compiler.compile("to FLASH; dhigh LED; wait 100; dlow LED; wait 100; end;");
+  compiler.compile("to GO; make \"N 0; forever FLASH; end;");
+  compiler.compile("GO");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  
+  LogoSizes sizes;
+  compiler.measure(&sizes);
+  
+  // the same as the flash code that's written.
+  stringstream code;
+  logo.dumpinst(&compiler, "code_test", code);
+  short rows = 0;
+  string line;
+  while (getline(code, line)) {
+    if (line.find("{ ") != string::npos) {
+      rows++;
+    }
+  }
+  BOOST_CHECK_EQUAL(sizes._code, rows);
+  BOOST_CHECK_EQUAL(sizes._jcode, 2);
+  BOOST_CHECK_EQUAL(sizes._vars, 1);
+  BOOST_CHECK_EQUAL(sizes._words, 3);
+  BOOST_CHECK_EQUAL(sizes._lists, 0);
+  BOOST_CHECK(sizes._stack > 0);
+  
+  stringstream config;
+  LogoCompiler::writeconfig(sizes, "test", config);
+  BOOST_CHECK(config.str().find("#define LOGO_SIZED") != string::npos);
+  BOOST_CHECK(config.str().find("#define MAX_CODE            " + to_string(rows)) != string::npos);
+  BOOST_CHECK(config.str().find("#define START_JCODE         2") != string::npos);
+  BOOST_CHECK(config.str().find("#define MAX_VARS            1") != string::npos);
+  BOOST_CHECK(config.str().find("#define MAX_WORDS           3") != string::npos);
+  BOOST_CHECK(config.str().find("#define MAX_STACK           " + to_string(sizes._stack + 2)) != string::npos);
+  
+  // a word that calls itself can't be sized.
+  compiler.compile("to DOWN :N; if :N > 0 [ DOWN :N - 1 ]; end;");
+  compiler.measure(&sizes);
+  BOOST_CHECK_EQUAL(sizes._stack, -1);
+  config.str("");
+  LogoCompiler::writeconfig(sizes, "test", config);
+  BOOST_CHECK(config.str().find("#define MAX_STACK           64") != string::npos);
+  
+}
@@ -138,3 +138,50 @@ BOOST_AUTO_TEST_CASE( printMixedList )
   BOOST_CHECK_EQUAL(s.str(), "=== This is a 0 and this is a 1.200000\n");
   
 }
+
+BOOST_AUTO_TEST_CASE( printConstListRepeated )
+{
+  cout << "=== printConstListRepeated ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+
+  // built once when compiled so running it more than the pool would hold is fine.
+  compiler.compile("to P; print [a b c]; end;");
+  compiler.compile("repeat 20 P");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  stringstream s;
+  logo.setout(&s);
+
+  DEBUG_STEP_DUMP(100, false);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  string expected;
+  for (int i=0; i<20; i++) {
+    expected += "=== a b c\n";
+  }
+  BOOST_CHECK_EQUAL(s.str(), expected);
+  
+}
+
+BOOST_AUTO_TEST_CASE( printListWithVariable )
+{
+  cout << "=== printListWithVariable ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("make \"X 5");
+  compiler.compile("print [a :X]");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  stringstream s;
+  logo.setout(&s);
+
+  DEBUG_STEP_DUMP(10, false);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(s.str(), "=== a 5\n");
+  
+}
@@ -18,6 +18,11 @@
 
 #include "../logo.hpp"
 #include "../logowords.hpp"
+#include "../logocompiler.hpp"
+#include "../logoblesession.hpp"
+#include "../logoserial.hpp"
+
+#include <sstream>
 
 using namespace std;
 
@@ -42,3 +47,198 @@ BOOST_AUTO_TEST_CASE( extractObjEvent )
   BOOST_CHECK_EQUAL(s, "id");
   
 }
+
+BOOST_AUTO_TEST_CASE( extractNotEvent )
+{
+  cout << "=== extractNotEvent ===" << endl;
+  
+  char s[8];  
+  LogoSimpleString evt1("{\"id\": 1}");
+  BOOST_CHECK(!LogoWords::extractEventName(&evt1, s, sizeof(s)));
+  LogoSimpleString evt2("[\"id\"]");
+  BOOST_CHECK(!LogoWords::extractEventName(&evt2, s, sizeof(s)));
+  LogoSimpleString evt3("[\"waytoolong\", 1]");
+  BOOST_CHECK(!LogoWords::extractEventName(&evt3, s, sizeof(s)));
+  LogoSimpleString evt4(" [ \"a\\\"b\" , 1]");
+  BOOST_CHECK(LogoWords::extractEventName(&evt4, s, sizeof(s)));
+  BOOST_CHECK_EQUAL(s, "a\"b");
+  
+}
+
+BOOST_AUTO_TEST_CASE( bleSession )
+{
+  cout << "=== bleSession ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+  LogoBLELoopback transport(&logo, &compiler);
+  LogoBLESession session(&transport, 3);
+  
+  stringstream s;
+  logo.setout(&s);
+
+  BOOST_CHECK(session.open());
+  
+  // the code is much longer than a single write.
+  BOOST_CHECK(session.sendcode(
+    "to SAYHELLO\n"
+    "  print \"hello\n"
+    "end\n"
+    "to SAYGOODBYE\n"
+    "  print \"goodbye\n"
+    "end\n"
+    "SAYHELLO SAYGOODBYE\n"));
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(s.str(), "=== hello\n=== goodbye\n");
+  
+  // only some of them waited.
+  BOOST_CHECK(session.writes() > 3);
+  BOOST_CHECK_EQUAL(transport.roundtrips(), session.requests());
+  BOOST_CHECK(session.requests() <= session.writes() / 3 + 1);
+  
+  // and send another on the same connection.
+  s.str("");
+  BOOST_CHECK(session.isopen());
+  BOOST_CHECK(session.sendcode("SAYGOODBYE"));
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(s.str(), "=== goodbye\n");
+  
+  session.close();
+  BOOST_CHECK(!session.isopen());
+  BOOST_CHECK(!session.sendcode("SAYGOODBYE"));
+  
+}
+
+BOOST_AUTO_TEST_CASE( bleSessionNoWindow )
+{
+  cout << "=== bleSessionNoWindow ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+  LogoBLELoopback transport(&logo, &compiler);
+  LogoBLESession session(&transport, 1);
+  
+  // every write waits.
+  BOOST_CHECK(session.open());
+  BOOST_CHECK(session.sendcode("print \"hello\n"));
+  BOOST_CHECK_EQUAL(session.requests(), session.writes());
+  BOOST_CHECK(session.sync());
+  BOOST_CHECK_EQUAL(session.requests(), session.writes());
+  
+}
+
+BOOST_AUTO_TEST_CASE( bleSessionImage )
+{
+  cout << "=== bleSessionImage ===" << endl;
+  
+  const char *code = "to SAY :X; print :X; end; SAY \"hello; SAY 42\n";
+  string image;
+  {
+    Logo logo;
+    LogoCompiler compiler(&logo);
+    compiler.setconstlists(false);
+    compiler.compile(code);
+    BOOST_CHECK_EQUAL(logo.geterr(), 0);
+    compiler.writeimage(&image);
+  }
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+  LogoBLELoopback transport(&logo, &compiler);
+  LogoBLESession session(&transport, 3);
+  stringstream s;
+  logo.setout(&s);
+
+  BOOST_CHECK(session.open());
+  BOOST_CHECK(session.sendimage(image));
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(s.str(), "=== hello\n=== 42\n");
+  
+  // and the text is still fine after it.
+  s.str("");
+  BOOST_CHECK(session.sendcode("SAY \"again\n"));
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(s.str(), "=== again\n");
+  
+}
+
+BOOST_AUTO_TEST_CASE( serialPaste )
+{
+  cout << "=== serialPaste ===" << endl;
+  
+  // a whole program pasted in, read in whatever pieces the port has.
+  string program(SERIAL_BUFFER_LEN - 5, '\n');
+  for (int i=0; i<12; i++) {
+    program += "to W" + to_string(i) + "; print " + to_string(i) + "; end\r\n";
+  }
+  
+  LogoSerialBuffer buffer;
+  vector<string> cmds;
+  size_t sent = 0;
+  int piece = 1;
+  while (sent < program.size()) {
+    char *p;
+    short len = buffer.space(&p);
+    BOOST_CHECK(len > 0);
+    len = min(len, (short)min((size_t)piece, program.size() - sent));
+    memcpy(p, program.c_str() + sent, len);
+    buffer.wrote(len);
+    sent += len;
+    piece = (piece * 7) % 97 + 1;
+    LogoSimpleString cmd;
+    while (buffer.ready(&cmd)) {
+      // it's right there in the buffer.
+      BOOST_CHECK(cmd.c_str() >= p - SERIAL_BUFFER_LEN && cmd.c_str() < p + SERIAL_BUFFER_LEN);
+      BOOST_CHECK_EQUAL(cmd.c_str()[cmd.length()], 0);
+      cmds.push_back(string(cmd.c_str(), cmd.length()));
+      buffer.next();
+    }
+  }
+  BOOST_CHECK_EQUAL(cmds.size(), 36);
+  BOOST_CHECK_EQUAL(cmds[0], "to W0");
+  BOOST_CHECK_EQUAL(cmds[1], " print 0");
+  BOOST_CHECK_EQUAL(cmds[35], " end");
+  BOOST_CHECK_EQUAL(buffer.overruns(), 0);
+
+  // and it all compiles.
+  Logo logo;
+  LogoCompiler compiler(&logo);
+  for (auto i: cmds) {
+    BOOST_CHECK_EQUAL(compiler.command(i.c_str()), 0);
+  }
+  BOOST_CHECK_EQUAL(compiler.command("W11"), 0);
+  stringstream s;
+  logo.setout(&s);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(s.str(), "=== 11\n");
+  
+}
+
+BOOST_AUTO_TEST_CASE( serialOverrun )
+{
+  cout << "=== serialOverrun ===" << endl;
+  
+  LogoSerialBuffer buffer;
+  string big(SERIAL_BUFFER_LEN + 10, 'X');
+  buffer.write("A;");
+  LogoSimpleString cmd;
+  BOOST_CHECK(buffer.ready(&cmd));
+  BOOST_CHECK_EQUAL(cmd.c_str(), "A");
+  buffer.next();
+  
+  // too long to ever fit so it's thrown away up to the end of it.
+  for (size_t i=0; i<big.size(); i+=32) {
+    buffer.write(big.substr(i, 32).c_str());
+    BOOST_CHECK(!buffer.ready(&cmd));
+  }
+  buffer.write("XXX\nB\n");
+  BOOST_CHECK(buffer.ready(&cmd));
+  BOOST_CHECK_EQUAL(cmd.c_str(), "B");
+  buffer.next();
+  BOOST_CHECK(!buffer.ready(&cmd));
+  BOOST_CHECK_EQUAL(buffer.overruns(), 1);
+  
+}
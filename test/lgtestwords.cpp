@@ -18,6 +18,7 @@
 
 #include "../logo.hpp"
 #include "../logocompiler.hpp"
+#include "../logojson.hpp"
 
 #include <iostream>
 #include <vector>
@@ -1247,3 +1248,736 @@ BOOST_AUTO_TEST_CASE( intWord )
   DEBUG_DUMP(false);
 
 }
+
+BOOST_AUTO_TEST_CASE( intArithmetic )
+{
+  cout << "=== intArithmetic ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("((3 - 1) * 4) + 2");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  DEBUG_STEP_DUMP(10, false);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK(logo.isstackint());
+  BOOST_CHECK_EQUAL(logo.popint(), 10);
+  
+  logo.resetcode();
+  compiler.compile("3 > 2");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK(logo.isstackint());
+  BOOST_CHECK_EQUAL(logo.popint(), 1);
+  
+}
+
+BOOST_AUTO_TEST_CASE( mixedArithmetic )
+{
+  cout << "=== mixedArithmetic ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("3 + 1.5");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  DEBUG_STEP_DUMP(10, false);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK(logo.isstackdouble());
+  BOOST_CHECK_EQUAL(logo.popdouble(), 4.5);
+  
+  logo.resetcode();
+  compiler.compile("\"3 * 2");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(logo.popdouble(), 6);
+  
+  logo.resetcode();
+  compiler.compile("2.5 < 3");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(logo.popint(), 1);
+  
+}
+
+BOOST_AUTO_TEST_CASE( makeNumericString )
+{
+  cout << "=== makeNumericString ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("MAKE \"X \"5");
+  compiler.compile(":X");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK(logo.isstackint());
+  BOOST_CHECK_EQUAL(logo.popint(), 5);
+  
+  logo.resetcode();
+  compiler.compile("MAKE \"Y \"007");
+  compiler.compile(":Y");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK(logo.isstackstring());
+  LogoStringResult result;
+  logo.popstring(&result);
+  BOOST_CHECK_EQUAL(result.ncmp("007"), 0);
+  
+}
+
+BOOST_AUTO_TEST_CASE( stringArithmetic )
+{
+  cout << "=== stringArithmetic ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("MAKE \"X \"2.5");
+  compiler.compile("MAKE \"Y :X + 1");
+  compiler.compile("MAKE \"Z :X * 2");
+  compiler.compile(":Y + :Z");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(logo.popdouble(), 8.5);
+  
+}
+
+BOOST_AUTO_TEST_CASE( printNumbers )
+{
+  cout << "=== printNumbers ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("print 32767 print (0 - 5) print 0 print 1.5 print (0 - 0.25) print (1 - 13.5)");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  stringstream s;
+  logo.setout(&s);
+
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(s.str(), "=== 32767\n=== -5\n=== 0\n=== 1.500000\n=== -0.250000\n=== -12.500000\n");
+  
+}
+
+BOOST_AUTO_TEST_CASE( waitWordWaiting )
+{
+  cout << "=== waitWordWaiting ===" << endl;
+  
+  TestWordTimeProvider time;
+  Logo logo(&time);
+  LogoCompiler compiler(&logo);
+ 
+  compiler.compile("TO ON; print \"ON; END");
+  compiler.compile("WAIT 1000 ON");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  time.settime(0);
+  logo.setidledelay(false);
+  
+  stringstream s;
+  logo.setout(&s);
+
+  // step until the WAIT has happened.
+  BOOST_CHECK(!logo.waiting());
+  for (int i=0; i<10 && !logo.waiting(); i++) {
+    BOOST_CHECK_EQUAL(logo.step(), 0);
+  }
+  BOOST_CHECK(logo.waiting());
+  
+  // without the idle delay, time doesn't move so we are still waiting.
+  for (int i=0; i<10; i++) {
+    BOOST_CHECK_EQUAL(logo.step(), 0);
+  }
+  BOOST_CHECK(logo.waiting());
+  BOOST_CHECK_EQUAL(s.str(), "");
+
+  time.settime(1001);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK(!logo.waiting());
+  BOOST_CHECK_EQUAL(s.str(), "=== ON\n");
+
+}
+
+BOOST_AUTO_TEST_CASE( launchWord )
+{
+  cout << "=== launchWord ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("to TSK; print \"TSK; end;");
+  compiler.compile("LAUNCH TSK print \"MAIN");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  stringstream s;
+  logo.setout(&s);
+
+  // the main code finishes first, then the task and then it stops.
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(s.str(), "=== MAIN\n=== TSK\n");
+  BOOST_CHECK_EQUAL(logo.taskcount(), 0);
+  BOOST_CHECK_EQUAL(logo.currenttask(), 0);
+  
+}
+
+BOOST_AUTO_TEST_CASE( launchWait )
+{
+  cout << "=== launchWait ===" << endl;
+  
+  TestWordTimeProvider time;
+  Logo logo(&time);
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("to TICK; print \"A WAIT 100; end;");
+  compiler.compile("to TOCK; print \"B WAIT 250; end;");
+  compiler.compile("to FTICK; FOREVER TICK; end;");
+  compiler.compile("to FTOCK; FOREVER TOCK; end;");
+  compiler.compile("LAUNCH FTICK LAUNCH FTOCK");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  time.settime(0);
+  
+  stringstream s;
+  logo.setout(&s);
+
+  // each step is a ms so both run at their own pace.
+  for (int i=0; i<1000; i++) {
+    BOOST_CHECK_EQUAL(logo.step(), 0);
+  }
+  BOOST_CHECK_EQUAL(logo.taskcount(), 2);
+  
+  string out = s.str();
+  int a = 0, b = 0;
+  for (size_t i=out.find("=== "); i != string::npos; i=out.find("=== ", i+1)) {
+    if (out[i+4] == 'A') {
+      a++;
+    }
+    else if (out[i+4] == 'B') {
+      b++;
+    }
+  }
+  BOOST_CHECK(a >= 8 && a <= 10);
+  BOOST_CHECK(b >= 3 && b <= 4);
+  BOOST_CHECK_EQUAL(out.substr(0, 12), "=== A\n=== B\n");
+  
+  // a new command only restarts the main code.
+  logo.resetcode();
+  compiler.compile("print \"C");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  s.str("");
+  for (int i=0; i<50; i++) {
+    BOOST_CHECK_EQUAL(logo.step(), 0);
+  }
+  BOOST_CHECK_EQUAL(s.str().substr(0, 6), "=== C\n");
+  BOOST_CHECK_EQUAL(logo.taskcount(), 2);
+
+  logo.stoptasks();
+  BOOST_CHECK_EQUAL(logo.taskcount(), 0);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  
+}
+
+BOOST_AUTO_TEST_CASE( launchTooMany )
+{
+  cout << "=== launchTooMany ===" << endl;
+  
+  TestWordTimeProvider time;
+  Logo logo(&time);
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("to SLEEP; WAIT 1000; end;");
+  compiler.compile("LAUNCH SLEEP LAUNCH SLEEP LAUNCH SLEEP");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  BOOST_CHECK_EQUAL(logo.run(), LG_TOO_MANY_TASKS);
+  BOOST_CHECK_EQUAL(logo.taskcount(), 2);
+  
+}
+
+BOOST_AUTO_TEST_CASE( pinTiming )
+{
+  cout << "=== pinTiming ===" << endl;
+  
+  TestWordTimeProvider time;
+  LogoRecordingIO io(&time);
+  Logo logo(&time, 0, 0, &io);
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("to FLASH; dhigh 13 WAIT 100 dlow 13 WAIT 250; end;");
+  compiler.compile("pinout 13 REPEAT 3 FLASH");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  time.settime(0);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  
+  // every edge and when it happened, each step is about a ms.
+  vector<LogoIOEvent> w = io.writes(13);
+  BOOST_CHECK_EQUAL(w.size(), 6);
+  for (size_t i=0; i<w.size(); i++) {
+    BOOST_CHECK_EQUAL(w[i]._value, (i % 2) == 0 ? 1 : 0);
+    if (i > 0) {
+      unsigned long gap = w[i]._ms - w[i-1]._ms;
+      unsigned long want = (i % 2) == 1 ? 100 : 250;
+      BOOST_CHECK(gap >= want && gap <= want + 20);
+    }
+  }
+  BOOST_CHECK_EQUAL(io.level(13), 0);
+  BOOST_CHECK_EQUAL(io.events()[0]._event, IO_EV_MODE);
+  
+}
+
+BOOST_AUTO_TEST_CASE( pinCoalesce )
+{
+  cout << "=== pinCoalesce ===" << endl;
+  
+  LogoRecordingIO io;
+  Logo logo(0, 0, 0, &io);
+  LogoCompiler compiler(&logo);
+
+  // different pins go out together but a pin that changes back doesn't lose the pulse.
+  compiler.compile("dhigh 2 dhigh 3 dlow 4 dlow 2 dhigh 2");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  
+  short flushes = 0;
+  for (auto i: io.events()) {
+    if (i._event == IO_EV_FLUSH) {
+      flushes++;
+    }
+  }
+  BOOST_CHECK_EQUAL(flushes, 3);
+  vector<LogoIOEvent> w = io.writes(2);
+  BOOST_CHECK_EQUAL(w.size(), 3);
+  BOOST_CHECK_EQUAL(io.level(2), 1);
+  BOOST_CHECK_EQUAL(io.level(3), 1);
+  BOOST_CHECK_EQUAL(io.level(4), 0);
+
+  // and a read sees what was written.
+  io.clear();
+  io.setinput(5, 1);
+  logo.resetcode();
+  compiler.compile("dhigh 6 print dread 5");
+  stringstream s;
+  logo.setout(&s);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(s.str(), "=== 1\n");
+  BOOST_CHECK_EQUAL(io.events().size(), 3);
+  BOOST_CHECK_EQUAL(io.events()[1]._event, IO_EV_WRITE);
+  BOOST_CHECK_EQUAL(io.events()[2]._event, IO_EV_READ);
+  
+}
+
+static int countout(const string &out, char c) {
+
+  int n = 0;
+  for (size_t i=out.find("=== "); i != string::npos; i=out.find("=== ", i+1)) {
+    if (out[i+4] == c) {
+      n++;
+    }
+  }
+  return n;
+  
+}
+
+BOOST_AUTO_TEST_CASE( commandMain )
+{
+  cout << "=== commandMain ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+
+  stringstream s;
+  logo.setout(&s);
+
+  // nothing running so they just run on the main code.
+  BOOST_CHECK_EQUAL(compiler.command("print \"A"), 0);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(compiler.command("print \"B"), 0);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(s.str(), "=== A\n=== B\n");
+  BOOST_CHECK_EQUAL(logo.taskcount(), 0);
+
+  // only what each one needed was cleared.
+  BOOST_CHECK_EQUAL(compiler.command("print \"C"), 0);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(s.str(), "=== A\n=== B\n=== C\n");
+
+}
+
+BOOST_AUTO_TEST_CASE( commandAlongside )
+{
+  cout << "=== commandAlongside ===" << endl;
+  
+  TestWordTimeProvider time;
+  Logo logo(&time);
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("to TICK; print \"A WAIT 100; end;");
+  compiler.compile("to GO; FOREVER TICK; end;");
+  compiler.compile("to B; print \"B; end;");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  time.settime(0);
+  
+  stringstream s;
+  logo.setout(&s);
+
+  BOOST_CHECK_EQUAL(compiler.command("GO"), 0);
+  for (int i=0; i<250; i++) {
+    BOOST_CHECK_EQUAL(logo.step(), 0);
+  }
+  
+  // lots more than fits in the code, and the GO never stops.
+  for (int i=0; i<2000; i++) {
+    BOOST_CHECK_EQUAL(compiler.command("B"), 0);
+    for (int j=0; j<20; j++) {
+      BOOST_CHECK_EQUAL(logo.step(), 0);
+    }
+  }
+  for (int i=0; i<100; i++) {
+    BOOST_CHECK_EQUAL(logo.step(), 0);
+  }
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  BOOST_CHECK_EQUAL(logo.taskcount(), 0);
+  BOOST_CHECK_EQUAL(logo.commandcount(), 0);
+  
+  string out = s.str();
+  BOOST_CHECK_EQUAL(countout(out, 'B'), 2000);
+  BOOST_CHECK(countout(out, 'A') > 10);
+  
+  // and it's still going.
+  s.str("");
+  for (int i=0; i<300; i++) {
+    BOOST_CHECK_EQUAL(logo.step(), 0);
+  }
+  BOOST_CHECK(countout(s.str(), 'A') >= 2);
+
+  // until the commands are reset.
+  logo.resetcode();
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  
+}
+
+BOOST_AUTO_TEST_CASE( commandWaiting )
+{
+  cout << "=== commandWaiting ===" << endl;
+  
+  TestWordTimeProvider time;
+  Logo logo(&time);
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("to SLEEP; WAIT 100; end;");
+  compiler.compile("to GO; FOREVER SLEEP; end;");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  time.settime(0);
+  
+  stringstream s;
+  logo.setout(&s);
+
+  // the main code and both tasks are busy so the rest wait their turn.
+  BOOST_CHECK_EQUAL(compiler.command("GO"), 0);
+  BOOST_CHECK_EQUAL(compiler.command("WAIT 200 print 1"), 0);
+  BOOST_CHECK_EQUAL(compiler.command("WAIT 300 print 2"), 0);
+  BOOST_CHECK_EQUAL(compiler.command("print 3"), 0);
+  BOOST_CHECK_EQUAL(compiler.command("print 4"), 0);
+  BOOST_CHECK_EQUAL(logo.taskcount(), 2);
+  BOOST_CHECK_EQUAL(logo.commandcount(), 2);
+  for (int i=0; i<100; i++) {
+    BOOST_CHECK_EQUAL(logo.step(), 0);
+  }
+  BOOST_CHECK_EQUAL(s.str(), "");
+  for (int i=0; i<400; i++) {
+    BOOST_CHECK_EQUAL(logo.step(), 0);
+  }
+  // they start in order as soon as there's a task for them.
+  BOOST_CHECK_EQUAL(s.str(), "=== 1\n=== 3\n=== 4\n=== 2\n");
+  BOOST_CHECK_EQUAL(logo.taskcount(), 0);
+  BOOST_CHECK_EQUAL(logo.commandcount(), 0);
+  
+}
+
+static short jsonfield(const char *json, const char *field, char *value, short len) {
+
+  // a character at a time is the hardest.
+  LogoJsonField f(field, value, len);
+  short result = JSON_MORE;
+  for (const char *c=json; *c && result == JSON_MORE; c++) {
+    result = f.feed(*c);
+  }
+  return result == JSON_MORE ? f.finish() : result;
+  
+}
+
+BOOST_AUTO_TEST_CASE( jsonField )
+{
+  cout << "=== jsonField ===" << endl;
+  
+  char value[16];
+  const char *json = "{ \"a\": { \"x\": \"inner\", \"b\": [1, \"}\"] }, \"x\": \"q\\\"\\u0041\\n\", "
+    "\"n\": -12.5, \"t\":true, \"o\": {}, \"l\": [1,2] }";
+  
+  BOOST_CHECK_EQUAL(jsonfield(json, "x", value, sizeof(value)), JSON_FOUND);
+  BOOST_CHECK_EQUAL(string(value), "q\"A\n");
+  BOOST_CHECK_EQUAL(jsonfield(json, "n", value, sizeof(value)), JSON_FOUND);
+  BOOST_CHECK_EQUAL(string(value), "-12.5");
+  BOOST_CHECK_EQUAL(jsonfield(json, "t", value, sizeof(value)), JSON_FOUND);
+  BOOST_CHECK_EQUAL(string(value), "true");
+  BOOST_CHECK_EQUAL(jsonfield("{\"n\":42}", "n", value, sizeof(value)), JSON_FOUND);
+  BOOST_CHECK_EQUAL(string(value), "42");
+  
+  // only at the top and not objects or lists.
+  BOOST_CHECK_EQUAL(jsonfield(json, "b", value, sizeof(value)), JSON_NOT_FOUND);
+  BOOST_CHECK_EQUAL(jsonfield(json, "o", value, sizeof(value)), JSON_NOT_FOUND);
+  BOOST_CHECK_EQUAL(jsonfield(json, "l", value, sizeof(value)), JSON_NOT_FOUND);
+  BOOST_CHECK_EQUAL(jsonfield(json, "xx", value, sizeof(value)), JSON_NOT_FOUND);
+  BOOST_CHECK_EQUAL(jsonfield("[\"x\", \"y\"]", "x", value, sizeof(value)), JSON_NOT_FOUND);
+  
+  BOOST_CHECK_EQUAL(jsonfield("{\"x\": \"0123456789abcdefg\"}", "x", value, sizeof(value)), JSON_TOO_LONG);
+  BOOST_CHECK_EQUAL(jsonfield("<html>", "x", value, sizeof(value)), JSON_BAD);
+  BOOST_CHECK_EQUAL(jsonfield("{\"y\": \"abc", "x", value, sizeof(value)), JSON_BAD);
+  
+}
+
+// serves the body in pieces and remembers how much it was asked for.
+class TestHttpStandIn: public LogoHttpStandIn {
+
+public:
+  TestHttpStandIn(const string &body, int code=200, int polls=0): _body(body), _code(code), _pos(0), _polls(polls) {}
+  
+  // it takes a while for the response to come back.
+  virtual bool ready() {
+    if (_polls > 0) {
+      _polls--;
+      return false;
+    }
+    return true;
+  }
+  virtual int get(const char *host, int port, const char *request) {
+    _url = string(host) + ":" + to_string(port) + request;
+    _pos = 0;
+    return _code;
+  }
+  virtual int read(char *buf, int len) {
+    int n = min(len, (int)(_body.size() - _pos));
+    memcpy(buf, _body.c_str() + _pos, n);
+    _pos += n;
+    return n;
+  }
+  
+  virtual int login(const char *host, int port, const char *user, const char *password, char *cookie, int len) {
+    snprintf(cookie, len, "session=%s", user);
+    return _code;
+  }
+  virtual bool connect(const char *ap, const char *password, char *ip, int len) {
+    strncpy(ip, "10.0.0.7", len);
+    return string(password) == "secret";
+  }
+  
+  string _body;
+  int _code;
+  size_t _pos;
+  int _polls;
+  string _url;
+  
+};
+
+BOOST_AUTO_TEST_CASE( wifiGet )
+{
+  cout << "=== wifiGet ===" << endl;
+  
+  // the field is near the start of a big body.
+  string body = "{ \"status\": \"ok\", \"items\": [";
+  for (int i=0; i<1000; i++) {
+    body += (i ? "," : "") + string("{ \"status\": \"inner\" }");
+  }
+  body += "], \"last\": 7 }";
+  TestHttpStandIn http(body);
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+  logo._wifi._http = &http;
+
+  compiler.compile("to SHOWERR; print &; end;");
+  compiler.compile("print wifiget \"host\" 8081 \"/things\" \"status\"");
+  compiler.compile("{ print wifiget \"host\" 8081 \"/things\" \"missing\" } SHOWERR");
+  compiler.compile("print wifiget \"host\" 8081 \"/things\" \"last\"");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  stringstream s;
+  logo.setout(&s);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(s.str(), "=== ok\n=== Field not found\n=== 7\n");
+  BOOST_CHECK_EQUAL(http._url, "host:8081/things");
+  
+  // it only read the start for the first one.
+  s.str("");
+  logo.resetcode();
+  compiler.compile("print wifiget \"host\" 8081 \"/things\" \"status\"");
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(s.str(), "=== ok\n");
+  BOOST_CHECK(http._pos < 100);
+  
+  TestHttpStandIn notfound("", 404);
+  logo._wifi._http = &notfound;
+  s.str("");
+  logo.resetcode();
+  compiler.compile("{ print wifiget \"host\" 80 \"/\" \"status\" } SHOWERR");
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(s.str(), "=== HTTP Error 404\n");
+  
+}
+
+BOOST_AUTO_TEST_CASE( wifiAsync )
+{
+  cout << "=== wifiAsync ===" << endl;
+  
+  TestHttpStandIn http("{ \"status\": \"ok\" }", 200, 100);
+  TestWordTimeProvider time;
+  Logo logo(&time);
+  LogoCompiler compiler(&logo);
+  logo._wifi._http = &http;
+
+  // the lights keep flashing while we wait for the server.
+  compiler.compile("to FLASH; print \"A WAIT 10; end;");
+  compiler.compile("to FFLASH; FOREVER FLASH; end;");
+  compiler.compile("LAUNCH FFLASH print wifiget \"host\" 80 \"/\" \"status\" print \"B");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  time.settime(0);
+  stringstream s;
+  logo.setout(&s);
+  for (int i=0; i<500; i++) {
+    BOOST_CHECK_EQUAL(logo.step(), 0);
+  }
+  string out = s.str();
+  size_t ok = out.find("=== ok\n=== B\n");
+  BOOST_CHECK(ok != string::npos);
+  BOOST_CHECK(out.substr(0, ok).find("=== A\n=== A\n=== A\n") != string::npos);
+  BOOST_CHECK(out.find("=== A\n", ok) != string::npos);
+  BOOST_CHECK_EQUAL(http._polls, 0);
+  logo.stoptasks();
+  
+}
+
+BOOST_AUTO_TEST_CASE( wifiAsyncWords )
+{
+  cout << "=== wifiAsyncWords ===" << endl;
+  
+  TestHttpStandIn http("", 200, 3);
+  Logo logo;
+  LogoCompiler compiler(&logo);
+  logo._wifi._http = &http;
+
+  compiler.compile("to SHOWERR; print &; end;");
+  compiler.compile("print wificonnect \"ap\" \"secret\"");
+  compiler.compile("{ print wificonnect \"ap\" \"wrong\" } SHOWERR");
+  compiler.compile("print wifilogin \"host\" 443 \"fred\" \"pass\"");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  stringstream s;
+  logo.setout(&s);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(s.str(), "=== 10.0.0.7\n=== Connect failed\n=== session=fred\n");
+  
+  // starting again while it's waiting just forgets it.
+  http._polls = 1000;
+  s.str("");
+  logo.resetcode();
+  compiler.compile("print wifiget \"host\" 80 \"/\" \"status\"");
+  for (int i=0; i<10; i++) {
+    BOOST_CHECK_EQUAL(logo.step(), 0);
+  }
+  BOOST_CHECK(logo._wifi.pending(0));
+  logo.resetcode();
+  BOOST_CHECK(!logo._wifi.pending(0));
+  compiler.compile("print \"C");
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  BOOST_CHECK_EQUAL(s.str(), "=== C\n");
+  
+}
+
+BOOST_AUTO_TEST_CASE( whenEvents )
+{
+  cout << "=== whenEvents ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("to FLASH; print \"F; end;");
+  compiler.compile("to DIM; print \"D; end;");
+  compiler.compile("WHEN \"update FLASH WHEN \"dim DIM");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  DEBUG_DUMP(false);
+
+  stringstream s;
+  logo.setout(&s);
+  BOOST_CHECK_EQUAL(logo.run(), 0);
+  
+  // a burst of more than the queue holds, put in whenever there's room.
+  int sent = 0;
+  for (int i=0; i<1000 && sent < 30; i++) {
+    while (sent < 30 && !logo._events.full()) {
+      const char *name = (sent % 3) == 0 ? "dim" : (sent % 3) == 1 ? "update" : "other";
+      BOOST_CHECK(logo._events.push(name, strlen(name), "[]", 2));
+      sent++;
+    }
+    logo.step();
+  }
+  for (int i=0; i<200; i++) {
+    logo.step();
+  }
+  BOOST_CHECK_EQUAL(sent, 30);
+  BOOST_CHECK(logo._events.empty());
+  
+  // every one we have a word for ran and nothing else.
+  string out = s.str();
+  int f = 0, d = 0;
+  for (size_t i=out.find("=== "); i != string::npos; i=out.find("=== ", i+1)) {
+    if (out[i+4] == 'F') {
+      f++;
+    }
+    else if (out[i+4] == 'D') {
+      d++;
+    }
+  }
+  BOOST_CHECK_EQUAL(f, 10);
+  BOOST_CHECK_EQUAL(d, 10);
+  BOOST_CHECK_EQUAL(logo.taskcount(), 0);
+  
+}
+
+BOOST_AUTO_TEST_CASE( whenTooMany )
+{
+  cout << "=== whenTooMany ===" << endl;
+  
+  Logo logo;
+  LogoCompiler compiler(&logo);
+
+  compiler.compile("to A; print 1; end;");
+  compiler.compile("WHEN \"a A WHEN \"b A WHEN \"c A WHEN \"a A WHEN \"d A WHEN \"e A");
+  BOOST_CHECK_EQUAL(logo.geterr(), 0);
+  BOOST_CHECK_EQUAL(logo.run(), LG_TOO_MANY_HANDLERS);
+  
+}
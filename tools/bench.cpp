@@ -0,0 +1,442 @@
+/*
+  bench.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 19-Oct-2026
+
+  Benchmark the compiler and the runtime with the examples and some synthetic
+  workloads and output the results as JSON so they can be compared across changes.
+
+  This work is licensed under the Creative Commons Attribution 4.0 International License.
+  To view a copy of this license, visit http://creativecommons.org/licenses/by/4.0/ or
+  send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+  https://github.com/visualopsholdings/tinylogo
+*/
+
+#include "../logo.hpp"
+#include "../logocompiler.hpp"
+#include "../logojson.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <chrono>
+#include <map>
+#include <algorithm>
+#include <boost/program_options.hpp>
+#include <boost/filesystem.hpp>
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+using namespace std;
+
+// WAIT never actually waits so we measure the interpreter not the delays.
+class NoWaitTimeProvider: public LogoTimeProvider {
+
+public:
+
+  unsigned long currentms() {
+    return 0;
+  }
+  void delayms(unsigned long ms) {
+  }
+  bool testing(short ms) {
+    return true;
+  }
+
+};
+
+typedef struct {
+  string name;
+  vector<string> lines;
+} Workload;
+
+static Workload synthetic(const string &name, const char *code) {
+
+  Workload w;
+  w.name = name;
+  stringstream str(code);
+  string line;
+  while (getline(str, line)) {
+    w.lines.push_back(line);
+  }
+  return w;
+
+}
+
+static bool loadfile(const fs::path &path, Workload *w) {
+
+  fstream file;
+  file.open(path.string(), ios::in);
+  if (!file) {
+    return false;
+  }
+  w->name = path.filename().string();
+  string line;
+  while (getline(file, line)) {
+    w->lines.push_back(line);
+  }
+  return true;
+
+}
+
+static int counttokens(const Workload &w) {
+
+  int count = 0;
+  for (auto i : w.lines) {
+    if (i.size() > 0 && i[0] == '#') {
+      continue;
+    }
+    stringstream str(i);
+    string token;
+    while (str >> token) {
+      count++;
+    }
+  }
+  return count;
+
+}
+
+static int compile(LogoCompiler *compiler, Logo *logo, const Workload &w) {
+
+  map<string, string> directives;
+  int n = 0;
+  for (auto i : w.lines) {
+    string line = i + "\n";
+    LogoCompiler::replacedirectives(&line, directives, true, &n);
+    compiler->compile(line.c_str());
+    int err = logo->geterr();
+    if (err) {
+      return err;
+    }
+  }
+  return 0;
+
+}
+
+static void bench(const Workload &w, int iterations, long maxsteps, bool first) {
+
+  typedef chrono::steady_clock clock;
+
+  NoWaitTimeProvider time;
+  ostream null(0);
+
+  int tokens = counttokens(w);
+  int err = 0;
+  long compilens = 0;
+  long runns = 0;
+  long steps = 0;
+  short stackpeak = 0;
+  short strings = 0;
+  short lists = 0;
+  short code = 0;
+  long pinwrites = 0;
+  long pinflushes = 0;
+
+  // directives and errors are printed to cout which would mess up the JSON.
+  streambuf *out = cout.rdbuf(0);
+  
+  for (int i=0; i<iterations && !err; i++) {
+
+    // the pins are recorded rather than printed.
+    LogoRecordingIO io(&time);
+    Logo logo(&time, 0, 0, &io);
+    LogoCompiler compiler(&logo);
+    logo.setout(&null);
+
+    clock::time_point start = clock::now();
+    err = compile(&compiler, &logo, w);
+    compilens += chrono::duration_cast<chrono::nanoseconds>(clock::now() - start).count();
+    if (err) {
+      break;
+    }
+    code = logo.codeused();
+
+    short e = 0;
+    long n = 0;
+    start = clock::now();
+    while (!e && n < maxsteps) {
+      e = logo.step();
+      n++;
+      if (logo.stackdepth() > stackpeak) {
+        stackpeak = logo.stackdepth();
+      }
+    }
+    logo.flushio();
+    runns += chrono::duration_cast<chrono::nanoseconds>(clock::now() - start).count();
+    steps += n;
+    for (auto j: io.events()) {
+      if (j._event == IO_EV_WRITE) {
+        pinwrites++;
+      }
+      else if (j._event == IO_EV_FLUSH) {
+        pinflushes++;
+      }
+    }
+    if (e && e != LG_STOP) {
+      err = e;
+    }
+
+    // the pools only grow so the end is the peak.
+    if (logo.stringsused() > strings) {
+      strings = logo.stringsused();
+    }
+    if (logo.listsused() > lists) {
+      lists = logo.listsused();
+    }
+  }
+  
+  cout.rdbuf(out);
+
+  cout << (first ? "" : ",") << endl;
+  cout << "    { \"name\": \"" << w.name << "\", ";
+  cout << "\"err\": " << err << ", ";
+  cout << "\"tokens\": " << tokens << ", ";
+  cout << "\"compile_ns_per_token\": " << (tokens > 0 ? compilens / iterations / tokens : 0) << ", ";
+  cout << "\"steps\": " << steps / iterations << ", ";
+  cout << "\"ns_per_step\": " << (steps > 0 ? (double)runns / steps : 0) << ", ";
+  cout << "\"code_used\": " << code << ", ";
+  cout << "\"stack_peak\": " << stackpeak << ", ";
+  cout << "\"strings_used\": " << strings << ", ";
+  cout << "\"lists_used\": " << lists << ", ";
+  cout << "\"pin_writes\": " << pinwrites / iterations << ", ";
+  cout << "\"pin_flushes\": " << pinflushes / iterations << " }";
+
+}
+
+// a server that has the body all ready to go, it remembers how much was read
+// and the biggest piece anyone asked for.
+class BenchHttpStandIn: public LogoHttpStandIn {
+
+public:
+  BenchHttpStandIn(const string &body): _body(body), _pos(0), _biggest(0) {}
+
+  int get(const char *host, int port, const char *request) {
+    _pos = 0;
+    return 200;
+  }
+  int read(char *buf, int len) {
+    if (len > _biggest) {
+      _biggest = len;
+    }
+    int n = min(len, (int)(_body.size() - _pos));
+    memcpy(buf, _body.c_str() + _pos, n);
+    _pos += n;
+    return n;
+  }
+
+  string _body;
+  size_t _pos;
+  int _biggest;
+
+};
+
+// a big JSON body with the field we want at the start, the middle or the end.
+static string jsonbody(int kb, const string &where) {
+
+  string items;
+  int i = 0;
+  while (items.size() < (size_t)kb * 1024) {
+    items += (i ? "," : "") + string("{ \"id\": ") + to_string(i) + ", \"name\": \"item\", \"tags\": [\"a\", \"b\"] }";
+    i++;
+  }
+  string field = "\"status\": \"ok\"";
+  if (where == "start") {
+    return "{ " + field + ", \"items\": [" + items + "] }";
+  }
+  if (where == "middle") {
+    return "{ \"before\": [" + items.substr(0, items.find("{", items.size() / 2) - 1) + "], " + field +
+      ", \"after\": [" + items.substr(items.find("{", items.size() / 2)) + "] }";
+  }
+  return "{ \"items\": [" + items + "], " + field + " }";
+
+}
+
+// how long WIFIGET takes to get the field and how much memory it needs to do it compared
+// to reading the whole body and then parsing it (what it used to do).
+static void benchwifiget(int kb, const string &where, int iterations, bool first) {
+
+  typedef chrono::steady_clock clock;
+
+  BenchHttpStandIn http(jsonbody(kb, where));
+  NoWaitTimeProvider time;
+  ostream null(0);
+  Logo logo(&time);
+  LogoCompiler compiler(&logo);
+  logo.setout(&null);
+  logo._wifi._http = &http;
+  compiler.compile("print wifiget \"localhost\" 80 \"/items\" \"status\"");
+  int err = logo.geterr();
+
+  long streamns = 0;
+  for (int i=0; i<iterations && !err; i++) {
+    clock::time_point start = clock::now();
+    err = logo.run();
+    streamns += chrono::duration_cast<chrono::nanoseconds>(clock::now() - start).count();
+    logo.restart();
+  }
+
+  // the whole body as a string, then a document as big as that.
+  long bufferedns = 0;
+  for (int i=0; i<iterations; i++) {
+    clock::time_point start = clock::now();
+    http.get("localhost", 80, "/items");
+    string body;
+    char chunk[WIFI_READ_LEN];
+    int n;
+    while ((n = http.read(chunk, sizeof(chunk))) > 0) {
+      body.append(chunk, n);
+    }
+    char value[256];
+    LogoJsonField json("status", value, sizeof(value));
+    for (size_t j=0; j<body.size() && json.feed(body.c_str() + j, min(body.size() - j, (size_t)16384)) == JSON_MORE; j+=16384) {
+    }
+    bufferedns += chrono::duration_cast<chrono::nanoseconds>(clock::now() - start).count();
+  }
+
+  // the streaming one needs the piece it reads into, the value and the parser.
+  long streampeak = http._biggest + 256 + sizeof(LogoJsonField);
+
+  // and the streaming one stopped here.
+  http.get("localhost", 80, "/items");
+  logo.run();
+
+  cout << (first ? "" : ",") << endl;
+  cout << "    { \"field_at\": \"" << where << "\", ";
+  cout << "\"err\": " << err << ", ";
+  cout << "\"body_bytes\": " << http._body.size() << ", ";
+  cout << "\"stream_bytes_read\": " << http._pos << ", ";
+  cout << "\"stream_us\": " << streamns / iterations / 1000.0 << ", ";
+  cout << "\"stream_peak_bytes\": " << streampeak << ", ";
+  cout << "\"buffered_us\": " << bufferedns / iterations / 1000.0 << ", ";
+  cout << "\"buffered_peak_bytes\": " << http._body.size() * 2 << " }";
+
+}
+
+int main(int argc, char *argv[]) {
+
+  po::options_description desc("Allowed options");
+  desc.add_options()
+    ("help", "produce help message")
+    ("examples", po::value<string>()->default_value("../logo"), "directory of .lgo examples")
+    ("iterations", po::value<int>()->default_value(20), "number of times to run each workload")
+    ("max-steps", po::value<long>()->default_value(100000), "most steps to run (for FOREVER)")
+    ("wifiget-kb", po::value<int>()->default_value(64), "size of the JSON body for WIFIGET")
+    ;
+  po::variables_map vm;
+  po::store(po::parse_command_line(argc, argv, desc), vm);
+  po::notify(vm);
+
+  if (vm.count("help")) {
+    cout << desc << endl;
+    return 1;
+  }
+
+  int iterations = vm["iterations"].as<int>();
+  if (iterations < 1) {
+    iterations = 1;
+  }
+  long maxsteps = vm["max-steps"].as<long>();
+
+  vector<Workload> workloads;
+
+  workloads.push_back(synthetic("tail_recursion",
+    "to DOWN\n"
+    "  make \"N :N - 1\n"
+    "  if :N > 0 DOWN\n"
+    "end\n"
+    "make \"N 1000\n"
+    "DOWN\n"));
+  workloads.push_back(synthetic("deep_recursion",
+    "to DEEP\n"
+    "  make \"N :N - 1\n"
+    "  if :N > 0 DEEP\n"
+    "  make \"D :D + 1\n"
+    "end\n"
+    "make \"N 500\n"
+    "make \"D 0\n"
+    "DEEP\n"));
+  workloads.push_back(synthetic("repeat_loop",
+    "to STEP\n"
+    "  make \"I :I + 1\n"
+    "  make \"J (:I * 3) - 2\n"
+    "end\n"
+    "make \"I 0\n"
+    "repeat 1000 STEP\n"));
+  workloads.push_back(synthetic("string_building",
+    "to GROW\n"
+    "  make \"S word :S \"ab\n"
+    "end\n"
+    "make \"S \"x\n"
+    "repeat 20 GROW\n"));
+  workloads.push_back(synthetic("list_building",
+    "to BUILD\n"
+    "  make \"X :X + 1\n"
+    "  make \"L [a :X b]\n"
+    "  make \"C [a b c d]\n"
+    "end\n"
+    "make \"X 0\n"
+    "repeat 10 BUILD\n"));
+  workloads.push_back(synthetic("variables",
+    "to VARS\n"
+    "  make \"A :A + 1\n"
+    "  make \"B :A + 2\n"
+    "  make \"C :B + 3\n"
+    "  make \"D :C + 4\n"
+    "  make \"E :D + 5\n"
+    "  make \"F :E + 6\n"
+    "  make \"G :F + 7\n"
+    "  make \"H :G + 8\n"
+    "end\n"
+    "make \"A 0\n"
+    "repeat 200 VARS\n"));
+  workloads.push_back(synthetic("bit_banging",
+    "to PULSE\n"
+    "  dhigh 2 dhigh 3\n"
+    "  dlow 2 dlow 3\n"
+    "end\n"
+    "pinout 2 pinout 3\n"
+    "repeat 500 PULSE\n"));
+
+  // and all the examples in alphabetical order so the output is stable.
+  fs::path examples(vm["examples"].as<string>());
+  vector<fs::path> files;
+  if (fs::is_directory(examples)) {
+    for (auto i : fs::directory_iterator(examples)) {
+      if (i.path().extension() == ".lgo") {
+        files.push_back(i.path());
+      }
+    }
+  }
+  sort(files.begin(), files.end());
+  for (auto i : files) {
+    Workload w;
+    if (loadfile(i, &w)) {
+      workloads.push_back(w);
+    }
+  }
+
+  cout << "{" << endl;
+  cout << "  \"iterations\": " << iterations << "," << endl;
+  cout << "  \"max_steps\": " << maxsteps << "," << endl;
+  cout << "  \"workloads\": [";
+  bool first = true;
+  for (auto i : workloads) {
+    bench(i, iterations, maxsteps, first);
+    first = false;
+  }
+  cout << endl << "  ]," << endl;
+  cout << "  \"wifiget\": [";
+  first = true;
+  for (auto i : { "start", "middle", "end" }) {
+    benchwifiget(vm["wifiget-kb"].as<int>(), i, iterations, first);
+    first = false;
+  }
+  cout << endl << "  ]" << endl;
+  cout << "}" << endl;
+
+  return 0;
+
+}
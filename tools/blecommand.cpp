@@ -28,7 +28,7 @@ int main(int argc, char *argv[]) {
   desc.add_options()
     ("help", "produce help message")
     ("name", po::value<string>(), "peripheral name")
-    ("command", po::value<string>(), "command")
+    ("command", po::value< vector<string> >()->composing(), "command (as many as you like)")
     ;
   po::positional_options_description p;
   p.add("input-file", -1);
@@ -46,18 +46,24 @@ int main(int argc, char *argv[]) {
   if (vm.count("name") && vm.count("command")) {
   
     auto name = vm["name"].as< string >();
-    auto command = vm["command"].as< string >() + "\n";
     
+    // all the commands on the one connection.
     LogoBLEClient client;
-    
-    if (!client.send(name, command)) {
-      cout << "Couldn't send" << endl;
+    LogoBLESession *session = client.open(name);
+    if (!session) {
+      cout << "Couldn't connect" << endl;
       return 1;
     }
+    for (auto command: vm["command"].as< vector<string> >()) {
+      if (!session->sendcode(command + "\n")) {
+        cout << "Couldn't send" << endl;
+        return 1;
+      }
+    }
+    client.close();
     
     return 0;
   }
     
   cout << desc << endl;
 }
-
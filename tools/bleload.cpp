@@ -14,22 +14,79 @@
 */
 
 #include "../logobleclnt.hpp"
+#include "../logo.hpp"
+#include "../logocompiler.hpp"
 
 #include <iostream>
 #include <boost/program_options.hpp> 
 #include <optional>
 #include <fstream>
+#include <chrono>
 
 namespace po = boost::program_options;
 using namespace std;
 
+// send the code to a lot of pretend devices to see how many writes and round trips it
+// takes without needing the radio.
+static int loopback(const string &contents, const optional<string> &image, int devices, short window) {
+
+  long writes = 0;
+  long roundtrips = 0;
+  long bytes = 0;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (int i=0; i<devices; i++) {
+    Logo logo;
+    LogoCompiler compiler(&logo);
+    LogoBLELoopback transport(&logo, &compiler);
+    LogoBLESession session(&transport, window);
+    if (!session.open() || !(image ? session.sendimage(*image) : session.sendcode(contents))) {
+      cout << "Couldn't send" << endl;
+      return 1;
+    }
+    int err = logo.geterr();
+    if (err) {
+      cout << "got compile err " << err << endl;
+      return err;
+    }
+    writes += session.writes();
+    roundtrips += transport.roundtrips();
+    bytes += session.bytes();
+  }
+  double secs = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count() / 1000000.0;
+  cout << "devices " << devices << " window " << window << " writes " << writes << " round trips " << roundtrips << " bytes " << bytes << " seconds " << secs << endl;
+  return 0;
+  
+}
+
+// compile it here so the device only has to copy it in.
+static optional<string> compileimage(const string &contents) {
+
+  Logo logo;
+  LogoCompiler compiler(&logo);
+  compiler.setconstlists(false);
+  compiler.compile(contents.c_str());
+  int err = logo.geterr();
+  if (err) {
+    cout << "got compile err " << err << endl;
+    return nullopt;
+  }
+  string image;
+  compiler.writeimage(&image);
+  cout << "text " << contents.size() << " bytes image " << image.size() << " bytes" << endl;
+  return image;
+  
+}
+
 int main(int argc, char *argv[]) {
 
   po::options_description desc("Allowed options");
   desc.add_options()
     ("help", "produce help message")
     ("input-file", po::value<string>(), "input file")
-    ("name", po::value<string>(), "peripheral name")
+    ("name", po::value< vector<string> >()->composing(), "peripheral name (as many as you like)")
+    ("window", po::value<int>()->default_value(BLE_WINDOW), "writes without a response before waiting for one")
+    ("loopback", po::value<int>(), "send to this many pretend devices instead")
+    ("image", "compile here and send the compiled image")
     ;
   po::positional_options_description p;
   p.add("input-file", -1);
@@ -44,10 +101,8 @@ int main(int argc, char *argv[]) {
     return 1;
   }
  
-  if (vm.count("name") && vm.count("input-file")) {
+  if ((vm.count("name") || vm.count("loopback")) && vm.count("input-file")) {
   
-    string infn = vm["input-file"].as< string >();
-    
     fstream file;
     file.open(vm["input-file"].as< string >(), ios::in);
     if (!file) {
@@ -60,17 +115,38 @@ int main(int argc, char *argv[]) {
       contents += line + "\n";
     }
 
-    auto name = vm["name"].as< string >();
-
-    LogoBLEClient client;
+    optional<string> image;
+    if (vm.count("image")) {
+      image = compileimage(contents);
+      if (!image) {
+        return 1;
+      }
+    }
     
-    if (!client.send(name, contents)) {
-      cout << "Couldn't send" << endl;
+    short window = vm["window"].as<int>();
+    if (vm.count("loopback")) {
+      return loopback(contents, image, vm["loopback"].as<int>(), window);
+    }
+    
+    // one scan for all of them and then they all stay connected so
+    // it's quick to send them something else.
+    LogoBLEClient client;
+    if (!client.scan()) {
       return 1;
     }
-    return 0;
+    int failed = 0;
+    for (auto name: vm["name"].as< vector<string> >()) {
+      LogoBLESession *session = client.open(name);
+      if (!session || !(image ? session->sendimage(*image) : session->sendcode(contents))) {
+        cout << "Couldn't send to " << name << endl;
+        failed++;
+        continue;
+      }
+      cout << "Sent " << name << " writes " << session->writes() << " waited " << session->requests() << endl;
+    }
+    client.close();
+    return failed ? 1 : 0;
   }
     
   cout << desc << endl;
 }
-
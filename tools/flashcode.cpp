@@ -6,6 +6,11 @@
   
   Write variables used to hold code and strings in flash memory.
   
+  With --config it also writes a header with the sizes the program needs.
+  
+  With --commands (or COMMANDS= on the //#LOGO line) only the words those, SETUP and
+  the code at the top can get to are written.
+  
   This work is licensed under the Creative Commons Attribution 4.0 International License. 
   To view a copy of this license, visit http://creativecommons.org/licenses/by/4.0/ or 
   send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
@@ -28,7 +33,26 @@ namespace fs = boost::filesystem;
 
 using namespace std;
 
-int process_ino(const string &infn) {
+int write_config(const string &configfn, const LogoSizes &sizes, const string &name) {
+
+  fstream file;
+  file.open(configfn, ios::out);
+  if (!file) {
+    cout << "Can't write " << configfn << endl;
+    return 1;
+  }
+  LogoCompiler::writeconfig(sizes, name, file);
+  file.close();
+  
+  cout << "wrote " << configfn << endl;
+  if (sizes._stack < 0) {
+    cout << "a word can call itself forever so the stack can't be sized" << endl;
+  }
+  return 0;
+  
+}
+
+int process_ino(const string &infn, const string &configfn) {
 
   cout << "processing .INO " << infn << endl;
   
@@ -42,7 +66,8 @@ int process_ino(const string &infn) {
   string outfn = infn + ".txt";
   fstream outfile;
   outfile.open(outfn, ios::out);
-  int err = LogoCompiler::updateino(infn, infile, outfile);
+  LogoSizes sizes = { 0, 0, 0, 0, 0, 0, 0 };
+  int err = LogoCompiler::updateino(infn, infile, outfile, &sizes);
   infile.close();
   outfile.close();
   
@@ -54,11 +79,14 @@ int process_ino(const string &infn) {
   fs::rename(infn, infn + ".old");
   fs::rename(outfn, infn);
   
+  if (!configfn.empty()) {
+    return write_config(configfn, sizes, inpath.filename().string());
+  }
   return 0;
   
 }
 
-int process_lgo(const string &infn, const string &name) {
+int process_lgo(const string &infn, const string &name, const string &commands, const string &configfn) {
 
   cout << "processing .LGO " << infn << endl;
   
@@ -70,8 +98,20 @@ int process_lgo(const string &infn, const string &name) {
   }
   map<string, string> directives;
   directives["NAME"] = name;
-  LogoCompiler::generatecode(file, directives, cout);
+  if (!commands.empty()) {
+    directives["COMMANDS"] = commands;
+  }
+  LogoSizes sizes = { 0, 0, 0, 0, 0, 0, 0 };
+  int err = LogoCompiler::generatecode(file, directives, cout, &sizes);
   file.close();
+  if (err) {
+    cout << "got error " << err << endl;
+    return err;
+  }
+  
+  if (!configfn.empty()) {
+    return write_config(configfn, sizes, name);
+  }
   return 0;
   
 }
@@ -83,6 +123,8 @@ int main(int argc, char *argv[]) {
     ("help", "produce help message")
     ("input-file", po::value<string>(), "input file")
     ("name", po::value<string>()->default_value("prog"), "variable name")
+    ("config", po::value<string>(), "write the sizes the program needs into this header (logoconfig.hpp)")
+    ("commands", po::value<string>(), "the words that can be called from the serial port eg GO,STOP, the words nothing can call are left out")
     ;
   po::positional_options_description p;
   p.add("input-file", -1);
@@ -98,12 +140,14 @@ int main(int argc, char *argv[]) {
   }
   if (vm.count("input-file") && vm.count("name")) {
     string infn = vm["input-file"].as< string >();
+    string configfn = vm.count("config") ? vm["config"].as< string >() : "";
     fs::path inpath(infn);
     if (inpath.extension() == ".ino") {
-      return process_ino(infn);
+      return process_ino(infn, configfn);
     }
     else if (inpath.extension() == ".lgo") {
-      return process_lgo(infn, vm["name"].as< string >());
+      string commands = vm.count("commands") ? vm["commands"].as< string >() : "";
+      return process_lgo(infn, vm["name"].as< string >(), commands, configfn);
     }
   }
   
@@ -0,0 +1,458 @@
+/*
+  fleet.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 19-Oct-2026
+
+  Simulate a fleet of devices all running the same program to see how it
+  behaves when they all get sent commands.
+
+  Each device is a Logo and a LogoCompiler set up just like a sketch does it.
+  They all share a virtual clock which moves on a tick at a time. Each device
+  runs a quantum of steps every tick (stopping at a WAIT) and gets sent the
+  commands in a script at its own phase, the same way LogoSketchBase does
+  when a command comes in on the serial port. The ticks are shared out over a
+  pool of threads that steal work from each other.
+
+  The script is a line for each command with the ms it is sent at and
+  the command:
+
+    0 ON
+    500 OFF
+
+  This work is licensed under the Creative Commons Attribution 4.0 International License.
+  To view a copy of this license, visit http://creativecommons.org/licenses/by/4.0/ or
+  send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+  https://github.com/visualopsholdings/tinylogo
+*/
+
+#include "../logo.hpp"
+#include "../logocompiler.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <deque>
+#include <map>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+// every device sees the same time which only moves when the fleet ticks.
+class VirtualTimeProvider: public LogoTimeProvider {
+
+public:
+  VirtualTimeProvider(const atomic<unsigned long> *clock): _clock(clock) {}
+
+  unsigned long currentms() {
+    return *_clock;
+  }
+  void delayms(unsigned long ms) {
+  }
+  bool testing(short ms) {
+    return false;
+  }
+
+private:
+  const atomic<unsigned long> *_clock;
+
+};
+
+typedef struct {
+  unsigned long _at; // ms from the start of the phase
+  string _cmd;
+} Command;
+
+// a single device.
+class Device {
+
+public:
+  Device(const atomic<unsigned long> *clock, unsigned long phase):
+    _time(clock), _logo(&_time), _compiler(&_logo), _out(0),
+    _phase(phase), _next(0), _idle(false), _failed(0), _errors(0), _steps(0) {}
+
+  VirtualTimeProvider _time;
+  Logo _logo;
+  LogoCompiler _compiler;
+  ostream _out; // throw away anything printed
+  unsigned long _phase; // when the script starts for this one
+  size_t _next; // the next command in the script
+  bool _idle; // stopped or got an error, nothing to do until a command
+  int _failed; // commands that didn't compile
+  int _errors; // errors while running
+  long _steps;
+  vector<long> _latency; // us from a command arriving to its first step
+
+};
+
+// a pool of threads with a queue each that steal from the other queues
+// when theirs is empty.
+class StealingPool {
+
+public:
+  StealingPool(int threads);
+  ~StealingPool();
+
+  // call f for 0 to n-1 and wait for them all.
+  void run(size_t n, function<void(size_t)> f);
+
+  int threads() const { return _queues.size(); }
+  long steals() const { return _steals; }
+
+private:
+  typedef struct {
+    mutex _mutex;
+    deque<size_t> _tasks;
+  } Queue;
+
+  vector<unique_ptr<Queue> > _queues;
+  vector<thread> _threads;
+  mutex _mutex;
+  condition_variable _start;
+  condition_variable _done;
+  function<void(size_t)> _f;
+  int _generation;
+  int _busy;
+  bool _stop;
+  atomic<long> _steals;
+
+  void work(int i);
+  bool pop(int i, size_t *task);
+
+};
+
+StealingPool::StealingPool(int threads): _generation(0), _busy(0), _stop(false), _steals(0) {
+
+  for (int i=0; i<threads; i++) {
+    _queues.push_back(unique_ptr<Queue>(new Queue()));
+  }
+  for (int i=0; i<threads; i++) {
+    _threads.push_back(thread(&StealingPool::work, this, i));
+  }
+
+}
+
+StealingPool::~StealingPool() {
+
+  {
+    lock_guard<mutex> lock(_mutex);
+    _stop = true;
+  }
+  _start.notify_all();
+  for (auto &t: _threads) {
+    t.join();
+  }
+
+}
+
+void StealingPool::run(size_t n, function<void(size_t)> f) {
+
+  unique_lock<mutex> lock(_mutex);
+
+  // each thread gets a run of them so the ones that finish first have
+  // something to steal.
+  size_t chunk = (n + _queues.size() - 1) / _queues.size();
+  for (size_t i=0; i<_queues.size(); i++) {
+    lock_guard<mutex> qlock(_queues[i]->_mutex);
+    for (size_t j=i*chunk; j<n && j<(i+1)*chunk; j++) {
+      _queues[i]->_tasks.push_back(j);
+    }
+  }
+  _f = f;
+  _busy = _queues.size();
+  _generation++;
+  _start.notify_all();
+  _done.wait(lock, [this]() { return _busy == 0; });
+
+}
+
+void StealingPool::work(int i) {
+
+  int generation = 0;
+  while (true) {
+    {
+      unique_lock<mutex> lock(_mutex);
+      _start.wait(lock, [this, generation]() { return _stop || _generation != generation; });
+      if (_stop) {
+        return;
+      }
+      generation = _generation;
+    }
+    size_t task;
+    while (pop(i, &task)) {
+      _f(task);
+    }
+    {
+      lock_guard<mutex> lock(_mutex);
+      _busy--;
+      if (_busy == 0) {
+        _done.notify_one();
+      }
+    }
+  }
+
+}
+
+bool StealingPool::pop(int i, size_t *task) {
+
+  // our own from the back.
+  {
+    lock_guard<mutex> lock(_queues[i]->_mutex);
+    if (!_queues[i]->_tasks.empty()) {
+      *task = _queues[i]->_tasks.back();
+      _queues[i]->_tasks.pop_back();
+      return true;
+    }
+  }
+
+  // then someone elses from the front.
+  for (size_t j=1; j<_queues.size(); j++) {
+    Queue *q = _queues[(i + j) % _queues.size()].get();
+    lock_guard<mutex> lock(q->_mutex);
+    if (!q->_tasks.empty()) {
+      *task = q->_tasks.front();
+      q->_tasks.pop_front();
+      _steals++;
+      return true;
+    }
+  }
+  return false;
+
+}
+
+static bool readscript(const string &fn, vector<Command> *script) {
+
+  fstream file;
+  file.open(fn, ios::in);
+  if (!file) {
+    cout << "Script not found" << endl;
+    return false;
+  }
+  string line;
+  while (getline(file, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    stringstream str(line);
+    Command c;
+    if (!(str >> c._at)) {
+      cout << "bad script line " << line << endl;
+      return false;
+    }
+    getline(str >> ws, c._cmd);
+    script->push_back(c);
+  }
+  // so we can just walk through them.
+  stable_sort(script->begin(), script->end(), [](const Command &a, const Command &b) {
+    return a._at < b._at;
+  });
+  return true;
+
+}
+
+static bool setup(Device *device, const string &program) {
+
+  device->_logo.setout(&device->_out);
+  device->_logo.setidledelay(false);
+
+  fstream file;
+  file.open(program, ios::in);
+  if (!file) {
+    return false;
+  }
+  map<string, string> directives;
+  device->_compiler.compile(file, directives, true);
+  if (device->_logo.geterr()) {
+    return false;
+  }
+
+  // just like LogoSketchBase::setup but since the clock isn't running yet
+  // a WAIT would never finish so stop there.
+  if (!device->_compiler.callword("SETUP")) {
+    int err = 0;
+    while (!err && !device->_logo.waiting()) {
+      err = device->_logo.step();
+    }
+    if (err && err != LG_STOP) {
+      return false;
+    }
+    device->_logo.restart();
+  }
+  return true;
+
+}
+
+static void tick(Device *device, const vector<Command> &script, unsigned long now, short quantum, Clock::time_point arrived) {
+
+  // any commands that have come in, just like LogoSketchBase::loop.
+  bool command = false;
+  while (device->_next < script.size() && script[device->_next]._at + device->_phase <= now) {
+    if (device->_compiler.command(script[device->_next]._cmd.c_str())) {
+      device->_failed++;
+    }
+    else {
+      command = true;
+      device->_idle = false;
+    }
+    device->_next++;
+  }
+
+  if (device->_idle) {
+    return;
+  }
+
+  // and then our quantum.
+  short steps = 0;
+  int err = 0;
+  do {
+    err = device->_logo.step();
+    if (err == LG_STOP) {
+      break;
+    }
+    steps++;
+    if (command && steps == 1) {
+      device->_latency.push_back(chrono::duration_cast<chrono::microseconds>(Clock::now() - arrived).count());
+    }
+    if (device->_logo.waiting()) {
+      break;
+    }
+  }
+  while (!err && steps < quantum);
+  device->_steps += steps;
+
+  if (err) {
+    if (err != LG_STOP) {
+      device->_errors++;
+    }
+    device->_idle = true;
+  }
+
+}
+
+static long percentile(const vector<long> &sorted, int p) {
+
+  if (sorted.empty()) {
+    return 0;
+  }
+  return sorted[min(sorted.size() - 1, sorted.size() * p / 100)];
+
+}
+
+int main(int argc, char *argv[]) {
+
+  po::options_description desc("Allowed options");
+  desc.add_options()
+    ("help", "produce help message")
+    ("input-file", po::value<string>(), "the .lgo file every device runs")
+    ("script", po::value<string>(), "the commands to send")
+    ("devices", po::value<int>()->default_value(1000), "how many devices")
+    ("threads", po::value<int>()->default_value(0), "how many threads (0 for all of them)")
+    ("seconds", po::value<double>()->default_value(10), "how long to run for in virtual time")
+    ("tick", po::value<int>()->default_value(10), "ms of virtual time for each tick")
+    ("quantum", po::value<int>()->default_value(100), "most steps for a device each tick")
+    ("stagger", po::value<int>()->default_value(0), "each device starts the script at a random ms up to this")
+    ("seed", po::value<int>()->default_value(1), "for the random stagger")
+    ;
+  po::positional_options_description p;
+  p.add("input-file", -1);
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv).
+          options(desc).positional(p).run(), vm);
+  po::notify(vm);
+
+  if (vm.count("help") || !vm.count("input-file")) {
+    cout << desc << endl;
+    return 1;
+  }
+
+  vector<Command> script;
+  if (vm.count("script") && !readscript(vm["script"].as<string>(), &script)) {
+    return 1;
+  }
+
+  int count = vm["devices"].as<int>();
+  int threads = vm["threads"].as<int>();
+  if (threads < 1) {
+    threads = thread::hardware_concurrency();
+  }
+  unsigned long tickms = max(1, vm["tick"].as<int>());
+  unsigned long endms = vm["seconds"].as<double>() * 1000;
+  short quantum = max(1, vm["quantum"].as<int>());
+  int stagger = vm["stagger"].as<int>();
+
+  // set them all up, quietly since the directives go to cout.
+  atomic<unsigned long> clock(0);
+  mt19937 random(vm["seed"].as<int>());
+  vector<unique_ptr<Device> > devices;
+  streambuf *out = cout.rdbuf(0);
+  bool ok = true;
+  for (int i=0; i<count && ok; i++) {
+    devices.push_back(unique_ptr<Device>(new Device(&clock, stagger > 0 ? random() % stagger : 0)));
+    ok = setup(devices.back().get(), vm["input-file"].as<string>());
+  }
+  cout.rdbuf(out);
+  if (!ok) {
+    cout << "setup failed" << endl;
+    return 1;
+  }
+
+  StealingPool pool(threads);
+  long ticks = 0;
+  Clock::time_point start = Clock::now();
+  for (; clock <= endms; clock += tickms) {
+    // all the commands for this tick arrive as it starts.
+    Clock::time_point arrived = Clock::now();
+    unsigned long now = clock;
+    pool.run(devices.size(), [&devices, &script, now, quantum, arrived](size_t i) {
+      tick(devices[i].get(), script, now, quantum, arrived);
+    });
+    ticks++;
+  }
+  double secs = chrono::duration_cast<chrono::microseconds>(Clock::now() - start).count() / 1000000.0;
+
+  long steps = 0;
+  int commands = 0;
+  int failed = 0;
+  int errors = 0;
+  short code = 0;
+  short strings = 0;
+  short lists = 0;
+  vector<long> latency;
+  for (auto &d: devices) {
+    steps += d->_steps;
+    commands += d->_next;
+    failed += d->_failed;
+    errors += d->_errors;
+    code = max(code, d->_logo.codeused());
+    strings = max(strings, d->_logo.stringsused());
+    lists = max(lists, d->_logo.listsused());
+    latency.insert(latency.end(), d->_latency.begin(), d->_latency.end());
+  }
+  sort(latency.begin(), latency.end());
+
+  cout << "devices " << devices.size() << " threads " << pool.threads() << " ticks " << ticks << " virtual seconds " << (ticks * tickms) / 1000.0 << endl;
+  cout << "bytes " << sizeof(Logo) + sizeof(LogoCompiler) << " (logo " << sizeof(Logo) << " compiler " << sizeof(LogoCompiler) << ")";
+  cout << " peak code " << code << " strings " << strings << " lists " << lists << endl;
+  cout << "commands " << commands << " failed " << failed << " errors " << errors << endl;
+  cout << "steps " << steps << " seconds " << secs << " steps/s " << (secs > 0 ? (long)(steps / secs) : 0) << " steals " << pool.steals() << endl;
+  cout << "latency us p50 " << percentile(latency, 50) << " p90 " << percentile(latency, 90);
+  cout << " p99 " << percentile(latency, 99) << " max " << (latency.empty() ? 0 : latency.back()) << endl;
+
+  return (failed || errors) ? 1 : 0;
+
+}
@@ -33,6 +33,8 @@ void RealTimeProvider::delayms(unsigned long ms) {
 }
 
 bool RealTimeProvider::testing(short ms) { 
-  cout << "WAIT " << ms << endl;
+  if (_verbose) {
+    cout << "WAIT " << ms << endl;
+  }
   return false; 
 };
@@ -21,11 +21,15 @@
 class RealTimeProvider: public LogoTimeProvider {
 
 public:
+  RealTimeProvider(bool verbose=true): _verbose(verbose) {}
 
   unsigned long currentms();
   void delayms(unsigned long ms);
   bool testing(short ms);
   
+private:
+  bool _verbose; // show each WAIT
+  
 };
 
 #endif // H_realtimeprovider
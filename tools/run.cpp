@@ -22,18 +22,144 @@
 #include <boost/program_options.hpp> 
 #include <fstream>
 #include <strstream>
+#include <sstream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
 
 namespace po = boost::program_options;
 using namespace std;
 
+// WAIT never actually waits so we can see how fast it can go.
+class NoWaitTimeProvider: public LogoTimeProvider {
+
+public:
+
+  unsigned long currentms() {
+    return 0;
+  }
+  void delayms(unsigned long ms) {
+  }
+  bool testing(short ms) {
+    return true;
+  }
+
+};
+
+// a single Logo running one of the files.
+class Job {
+
+public:
+  Job(const string &file, int instance, bool nowait): 
+    _file(file), _instance(instance), _time(false), 
+    _logo(nowait ? (LogoTimeProvider *)&_nowait : &_time), _compiler(&_logo),
+    _err(0), _steps(0) {}
+  
+  string _file;
+  int _instance;
+  RealTimeProvider _time;
+  NoWaitTimeProvider _nowait;
+  Logo _logo;
+  LogoCompiler _compiler;
+  stringstream _out;
+  int _err;
+  long _steps;
+  
+};
+
+static void runjob(Job *job, long maxsteps) {
+
+  job->_logo.setout(&job->_out);
+  
+  // the WAITs still wait but there's no delay between steps.
+  job->_logo.setidledelay(false);
+  
+  short err = 0;
+  while (!err && (maxsteps == 0 || job->_steps < maxsteps)) {
+    err = job->_logo.step();
+    job->_steps++;
+  }
+  if (err && err != LG_STOP) {
+    job->_err = err;
+  }
+  
+}
+
+static int runjobs(const vector<string> &files, int instances, int threads, long maxsteps, bool nowait) {
+
+  // compile them all first, quietly since the directives go to cout.
+  vector<Job *> jobs;
+  streambuf *out = cout.rdbuf(0);
+  for (auto f: files) {
+    for (int i=0; i<instances; i++) {
+      Job *job = new Job(f, i, nowait);
+      jobs.push_back(job);
+      fstream file;
+      file.open(f, ios::in);
+      if (!file) {
+        job->_err = LG_FILE_NOT_FOUND;
+        continue;
+      }
+      map<string, string> directives;
+      job->_compiler.compile(file, directives, true);
+      job->_err = job->_logo.geterr();
+    }
+  }
+  cout.rdbuf(out);
+  
+  // and then run them all on as many threads as we can.
+  atomic<size_t> next(0);
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  vector<thread> workers;
+  for (int i=0; i<threads; i++) {
+    workers.push_back(thread([&jobs, &next, maxsteps]() {
+      for (size_t j=next++; j<jobs.size(); j=next++) {
+        if (!jobs[j]->_err) {
+          runjob(jobs[j], maxsteps);
+        }
+      }
+    }));
+  }
+  for (auto &w: workers) {
+    w.join();
+  }
+  double secs = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count() / 1000000.0;
+  
+  // everything in order so the output of a regression pack can be compared.
+  long steps = 0;
+  int failed = 0;
+  for (auto job: jobs) {
+    cout << "--- " << job->_file << " (" << job->_instance << ")" << endl;
+    cout << job->_out.str();
+    if (job->_err) {
+      cout << "got err " << job->_err << endl;
+      failed++;
+    }
+    steps += job->_steps;
+    delete job;
+  }
+  cout << "jobs " << jobs.size() << " threads " << threads << " failed " << failed << endl;
+  cout << "steps " << steps << " seconds " << secs << " steps/s " << (secs > 0 ? (long)(steps / secs) : 0) << endl;
+  
+  return failed ? 1 : 0;
+  
+}
+
 int main(int argc, char *argv[]) {
 
   po::options_description desc("Allowed options");
   desc.add_options()
     ("help", "produce help message")
-    ("input-file", po::value<string>(), "input file")
+    ("input-file", po::value< vector<string> >(), "input file")
     ("dump", "dump after compile")
     ("step-dump", po::value<int>(), "step and dump this number of times")
+    ("profile", "print a profile of the words and builtins after running")
+    ("trace", "print the trace of the last steps after running (see tracedecode)")
+    ("jobs", po::value<int>(), "run all the files at once on this many threads")
+    ("instances", po::value<int>()->default_value(1), "with --jobs, how many of each file to run")
+    ("max-steps", po::value<long>()->default_value(0), "with --jobs, most steps for each (for FOREVER)")
+    ("no-wait", "with --jobs, don't wait at a WAIT")
     ;
   po::positional_options_description p;
   p.add("input-file", -1);
@@ -47,9 +173,17 @@ int main(int argc, char *argv[]) {
     cout << desc << endl;
     return 1;
   }
+  if (vm.count("input-file") && vm.count("jobs")) {
+    int threads = vm["jobs"].as<int>();
+    if (threads < 1) {
+      threads = thread::hardware_concurrency();
+    }
+    return runjobs(vm["input-file"].as< vector<string> >(), vm["instances"].as<int>(), threads, vm["max-steps"].as<long>(), vm.count("no-wait"));
+  }
+  
   if (vm.count("input-file")) {
     fstream file;
-    file.open(vm["input-file"].as< string >(), ios::in);
+    file.open(vm["input-file"].as< vector<string> >()[0], ios::in);
     if (!file) {
 		  cout << "File not found" << endl;
 		  return 1;
@@ -82,7 +216,21 @@ int main(int argc, char *argv[]) {
       }
     }
     else {
+      if (vm.count("profile")) {
+        logo.startprofile();
+      }
+      if (vm.count("trace")) {
+        logo.starttrace();
+      }
       err = logo.run();
+      if (vm.count("profile")) {
+        logo.stopprofile();
+        logo.printprofile(&compiler);
+      }
+      if (vm.count("trace")) {
+        logo.stoptrace();
+        logo.printtrace();
+      }
       if (err) {
         cout << "got runerr " << err << endl;
         return err;
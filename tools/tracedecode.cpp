@@ -0,0 +1,187 @@
+/*
+  tracedecode.cpp
+
+  Author: Paul Hamilton (paul@visualops.com)
+  Date: 19-Oct-2026
+
+  Decode a trace dumped by the TRACE word (or run --trace) against the words
+  of the program that made it.
+
+  The trace can be the text that was printed (everything before "trace N" and
+  after "end" is ignored so you can give it a whole serial log) or with --binary
+  the bytes that were read from the BLE trace characteristic.
+
+  This work is licensed under the Creative Commons Attribution 4.0 International License.
+  To view a copy of this license, visit http://creativecommons.org/licenses/by/4.0/ or
+  send a letter to Creative Commons, PO Box 1866, Mountain View, CA 94042, USA.
+
+  https://github.com/visualopsholdings/tinylogo
+*/
+
+#include "../logo.hpp"
+#include "../logocompiler.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <boost/program_options.hpp>
+
+namespace po = boost::program_options;
+using namespace std;
+
+static int hexdigit(char c) {
+
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+
+}
+
+static bool readtext(fstream &file, vector<unsigned char> *bytes) {
+
+  string line;
+  bool intrace = false;
+  while (getline(file, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    if (line.find("trace ") == 0) {
+      // only the last trace in the log.
+      bytes->clear();
+      intrace = true;
+      continue;
+    }
+    if (!intrace) {
+      continue;
+    }
+    if (line == "end") {
+      intrace = false;
+      continue;
+    }
+    if (line.size() != TRACE_ENTRY_LEN * 2) {
+      cout << "bad trace line " << line << endl;
+      return false;
+    }
+    for (int i=0; i<TRACE_ENTRY_LEN; i++) {
+      int hi = hexdigit(line[i*2]);
+      int lo = hexdigit(line[i*2+1]);
+      if (hi < 0 || lo < 0) {
+        cout << "bad trace line " << line << endl;
+        return false;
+      }
+      bytes->push_back((hi << 4) | lo);
+    }
+  }
+  return true;
+
+}
+
+static bool readbinary(fstream &file, vector<unsigned char> *bytes) {
+
+  char c;
+  while (file.get(c)) {
+    bytes->push_back((unsigned char)c);
+  }
+  if (bytes->size() % TRACE_ENTRY_LEN) {
+    cout << "trace is not a whole number of entries" << endl;
+    return false;
+  }
+  return true;
+
+}
+
+int main(int argc, char *argv[]) {
+
+  po::options_description desc("Allowed options");
+  desc.add_options()
+    ("help", "produce help message")
+    ("program", po::value<string>(), "the .lgo file that was running")
+    ("input-file", po::value<string>(), "the trace")
+    ("binary", "the trace is binary, not text")
+    ;
+  po::positional_options_description p;
+  p.add("input-file", -1);
+
+  po::variables_map vm;
+  po::store(po::command_line_parser(argc, argv).
+          options(desc).positional(p).run(), vm);
+  po::notify(vm);
+
+  if (vm.count("help") || !vm.count("input-file")) {
+    cout << desc << endl;
+    return 1;
+  }
+
+  Logo logo;
+  LogoCompiler compiler(&logo);
+  if (vm.count("program")) {
+    fstream file;
+    file.open(vm["program"].as< string >(), ios::in);
+    if (!file) {
+		  cout << "Program not found" << endl;
+		  return 1;
+    }
+    map<string, string> directives;
+    compiler.compile(file, directives, true);
+    int err = logo.geterr();
+    if (err) {
+      cout << "got compile err " << err << endl;
+      return err;
+    }
+  }
+
+  bool binary = vm.count("binary");
+  fstream file;
+  file.open(vm["input-file"].as< string >(), binary ? ios::in | ios::binary : ios::in);
+  if (!file) {
+    cout << "File not found" << endl;
+    return 1;
+  }
+  vector<unsigned char> bytes;
+  if (!(binary ? readbinary(file, &bytes) : readtext(file, &bytes))) {
+    return 1;
+  }
+
+  cout << "us\tdelta\tpc\ttos\top\tword" << endl;
+  unsigned long first = 0;
+  unsigned long last = 0;
+  for (size_t i=0; i+TRACE_ENTRY_LEN<=bytes.size(); i+=TRACE_ENTRY_LEN) {
+    const unsigned char *entry = &bytes[i];
+    short pc = entry[0] | (entry[1] << 8);
+    short optype = entry[2];
+    short tos = entry[3];
+    unsigned long us = entry[4] | (entry[5] << 8) | (entry[6] << 16) | ((unsigned long)entry[7] << 24);
+    if (i == 0) {
+      first = us;
+      last = us;
+    }
+    // the time is only 32 bits so it might have wrapped.
+    cout << ((us - first) & 0xffffffff) << "\t";
+    cout << "+" << ((us - last) & 0xffffffff) << "\t";
+    cout << pc << "\t";
+    cout << tos << "\t";
+    logo.optypename(optype, cout);
+    cout << "\t";
+    char name[STRING_LEN];
+    if (compiler.wordat(pc, name, sizeof(name))) {
+      cout << name;
+    }
+    else {
+      cout << "(top)";
+    }
+    cout << endl;
+    last = us;
+  }
+
+  return 0;
+
+}